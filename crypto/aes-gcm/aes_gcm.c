@@ -1,47 +1,441 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+
+// The table GHASH is Shoup's 4-bit method: sixteen multiples of H and a
+// reduction table for the four bits shifted out each step.  Its lookups
+// depend on H and the data.  The PCLMULQDQ GHASH follows Gueron and
+// Kounavis, "Intel Carry-Less Multiplication Instruction and its Usage for
+// Computing the GCM Mode", with the reduction of four products aggregated.
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
-#include <stdio.h>
 
-#include "aes.h"
-#include "crypto.h"
-#include "util.h"
+#include "aes_gcm.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define AES_GCM_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
 
-#define BLOCK_SIZE 16
+#define BLOCK_SIZE          16
 
-static struct AES_ctx aes_ctx;
+// Counter blocks encrypted per cipher call
+#define CTR_BLOCKS          4
 
-// void AES_CTR_xcrypt_buffer(struct AES_ctx* ctx, uint8_t* buf, uint32_t length);
+#define GET64(p)    ((uint64_t)(p)[0] << 56 | (uint64_t)(p)[1] << 48 | (uint64_t)(p)[2] << 40 | \
+                     (uint64_t)(p)[3] << 32 | (uint64_t)(p)[4] << 24 | (uint64_t)(p)[5] << 16 | \
+                     (uint64_t)(p)[6] << 8 | (uint64_t)(p)[7])
 
-int8_t crypto_aes256_gcm_encrypt(uint8_t * data, uint32_t length, uint8_t * authtag)
+static void put64(uint8_t * p, uint64_t v)
 {
-    memset(authtag, 0, BLOCK_SIZE);
-    AES_CTR_xcrypt_buffer(&aes_ctx, authtag, BLOCK_SIZE);
+    int i;
 
-    return 0;
+    for (i = 7; i >= 0; i--)
+    {
+        p[i] = (uint8_t)v;
+        v >>= 8;
+    }
+}
+
+// Encrypt whole blocks in place with the raw cipher
+static void aes_encrypt_blocks(const crypto_aes_ctx * aes, uint8_t * blocks, uint32_t length)
+{
+#ifdef CRYPTO_AES_HOST
+    aes256_ecb_encrypt(aes, blocks, blocks, length);
+#else
+    uint32_t i;
+
+    for (i = 0; i < length; i += BLOCK_SIZE)
+    {
+        // Older tiny-AES takes a non-const context
+        AES_ECB_encrypt((crypto_aes_ctx *)aes, blocks + i);
+    }
+#endif
 }
 
-#ifdef TEST
+static const uint16_t last4[16] = {
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0,
+};
 
-int main(int argc, char * argv[])
+static void ghash_table_init(aes_gcm_ctx * ctx)
 {
-    uint8_t nonce[16];
-    uint8_t key[32];
-    uint8_t authtag[BLOCK_SIZE];
+    uint64_t vh, vl, t;
+    int i, j;
 
-    // uint8_t * authtag1 = (uint8_t *)"\x53\x0f\x8a\xfb\xc7\x45\x36\xb9\xa9\x63\xb4\xf1\xc4\xcb\x73\x8b";
+    vh = GET64(ctx->h);
+    vl = GET64(ctx->h + 8);
 
-    memset(nonce,0,16);
-    memset(key,0,16);
+    // Entries for single bits are H times x^0..x^3, bit 3 being x^0
+    ctx->hh[0] = 0;
+    ctx->hl[0] = 0;
+    ctx->hh[8] = vh;
+    ctx->hl[8] = vl;
+    for (i = 4; i > 0; i >>= 1)
+    {
+        t = (vl & 1) * 0xe1000000u;
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ (t << 32);
+        ctx->hh[i] = vh;
+        ctx->hl[i] = vl;
+    }
 
-    AES_init_ctx_iv(&aes_ctx, key, nonce);
+    for (i = 2; i <= 8; i *= 2)
+    {
+        for (j = 1; j < i; j++)
+        {
+            ctx->hh[i + j] = ctx->hh[i] ^ ctx->hh[j];
+            ctx->hl[i + j] = ctx->hl[i] ^ ctx->hl[j];
+        }
+    }
+}
 
-    crypto_aes256_gcm_encrypt(NULL, 0, authtag);
+// x = x * H, four bits at a time from the last byte
+static void ghash_table_mult(const aes_gcm_ctx * ctx, uint8_t * x)
+{
+    uint64_t zh, zl;
+    uint8_t lo, hi, rem;
+    int i;
 
-    printf("Auth tag: "); dump_hex(authtag, BLOCK_SIZE);
+    lo = x[15] & 0xf;
+    zh = ctx->hh[lo];
+    zl = ctx->hl[lo];
 
+    for (i = 15; i >= 0; i--)
+    {
+        lo = x[i] & 0xf;
+        hi = x[i] >> 4;
 
-    return 0;
+        if (i != 15)
+        {
+            rem = zl & 0xf;
+            zl = (zh << 60) | (zl >> 4);
+            zh = (zh >> 4) ^ ((uint64_t)last4[rem] << 48);
+            zh ^= ctx->hh[lo];
+            zl ^= ctx->hl[lo];
+        }
+
+        rem = zl & 0xf;
+        zl = (zh << 60) | (zl >> 4);
+        zh = (zh >> 4) ^ ((uint64_t)last4[rem] << 48);
+        zh ^= ctx->hh[hi];
+        zl ^= ctx->hl[hi];
+    }
+
+    put64(x, zh);
+    put64(x + 8, zl);
+}
+
+static void ghash_table(const aes_gcm_ctx * ctx, uint8_t * x, const uint8_t * data, uint32_t blocks)
+{
+    int i;
+
+    for (; blocks > 0; blocks--, data += BLOCK_SIZE)
+    {
+        for (i = 0; i < BLOCK_SIZE; i++)
+        {
+            x[i] ^= data[i];
+        }
+        ghash_table_mult(ctx, x);
+    }
+}
+
+#ifdef AES_GCM_X86
+
+// Product of byte reversed a and b, 256 bits in lo and hi, not yet shifted
+// into GCM's bit order
+__attribute__((target("pclmul,sse2")))
+static inline void clmul(__m128i a, __m128i b, __m128i * lo, __m128i * hi)
+{
+    __m128i mid;
+
+    *lo = _mm_clmulepi64_si128(a, b, 0x00);
+    *hi = _mm_clmulepi64_si128(a, b, 0x11);
+    mid = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01));
+    *lo = _mm_xor_si128(*lo, _mm_slli_si128(mid, 8));
+    *hi = _mm_xor_si128(*hi, _mm_srli_si128(mid, 8));
+}
+
+// Shift lo:hi left by one and reduce modulo x^128 + x^7 + x^2 + x + 1
+__attribute__((target("pclmul,sse2")))
+static inline __m128i clmul_reduce(__m128i lo, __m128i hi)
+{
+    __m128i t1, t2, t3;
+
+    t1 = _mm_srli_epi32(lo, 31);
+    t2 = _mm_srli_epi32(hi, 31);
+    lo = _mm_slli_epi32(lo, 1);
+    hi = _mm_slli_epi32(hi, 1);
+    t3 = _mm_srli_si128(t1, 12);
+    t2 = _mm_slli_si128(t2, 4);
+    t1 = _mm_slli_si128(t1, 4);
+    lo = _mm_or_si128(lo, t1);
+    hi = _mm_or_si128(hi, t2);
+    hi = _mm_or_si128(hi, t3);
+
+    t1 = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30)), _mm_slli_epi32(lo, 25));
+    t2 = _mm_srli_si128(t1, 4);
+    t1 = _mm_slli_si128(t1, 12);
+    lo = _mm_xor_si128(lo, t1);
+
+    t1 = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2)), _mm_srli_epi32(lo, 7));
+    t1 = _mm_xor_si128(t1, t2);
+    lo = _mm_xor_si128(lo, t1);
+    return _mm_xor_si128(hi, lo);
+}
+
+__attribute__((target("pclmul,sse2")))
+static inline __m128i clmul_mult(__m128i a, __m128i b)
+{
+    __m128i lo, hi;
+
+    clmul(a, b, &lo, &hi);
+    return clmul_reduce(lo, hi);
+}
+
+__attribute__((target("pclmul,ssse3")))
+static void ghash_pclmul(const aes_gcm_ctx * ctx, uint8_t * x, const uint8_t * data, uint32_t blocks)
+{
+    const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m128i h[4], y, b, lo, hi, l, u;
+    int i;
+
+    h[0] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)ctx->h), bswap);
+    y = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)x), bswap);
+
+    if (blocks >= 4)
+    {
+        // h[i] = H^(i + 1)
+        for (i = 1; i < 4; i++)
+        {
+            h[i] = clmul_mult(h[i - 1], h[0]);
+        }
+
+        // y = (y + b0) H^4 + b1 H^3 + b2 H^2 + b3 H
+        for (; blocks >= 4; blocks -= 4, data += 4 * BLOCK_SIZE)
+        {
+            b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)data), bswap);
+            clmul(_mm_xor_si128(y, b), h[3], &lo, &hi);
+            for (i = 1; i < 4; i++)
+            {
+                b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + i * BLOCK_SIZE)), bswap);
+                clmul(b, h[3 - i], &l, &u);
+                lo = _mm_xor_si128(lo, l);
+                hi = _mm_xor_si128(hi, u);
+            }
+            y = clmul_reduce(lo, hi);
+        }
+    }
+
+    for (; blocks > 0; blocks--, data += BLOCK_SIZE)
+    {
+        b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)data), bswap);
+        y = clmul_mult(_mm_xor_si128(y, b), h[0]);
+    }
+
+    _mm_storeu_si128((__m128i *)x, _mm_shuffle_epi8(y, bswap));
+}
+
+#endif   // AES_GCM_X86
+
+static const struct
+{
+    const char * name;
+    void (*ghash)(const aes_gcm_ctx * ctx, uint8_t * x, const uint8_t * data, uint32_t blocks);
+} backends[AES_GCM_BACKEND_COUNT] = {
+    [AES_GCM_BACKEND_TABLE] = { "table", ghash_table },
+#ifdef AES_GCM_X86
+    [AES_GCM_BACKEND_PCLMUL] = { "pclmul", ghash_pclmul },
+#endif
+};
+
+// Table based until gcm_select_auto() runs at load time, before main() and
+// any thread that could use GCM.
+static int gcm_backend = AES_GCM_BACKEND_TABLE;
+
+static int gcm_cpu_has(int backend)
+{
+#ifdef AES_GCM_X86
+    unsigned int eax, ebx, ecx, edx;
+#endif
+
+    if (backend <= AES_GCM_BACKEND_AUTO || backend >= AES_GCM_BACKEND_COUNT ||
+        backends[backend].ghash == NULL)
+    {
+        return 0;
+    }
+
+    switch (backend)
+    {
+#ifdef AES_GCM_X86
+        case AES_GCM_BACKEND_PCLMUL:
+            return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_PCLMUL) && (ecx & bit_SSSE3);
+#endif
+        default:
+            return 1;
+    }
+}
+
+int crypto_aes256_gcm_select_backend(int backend)
+{
+    if (backend == AES_GCM_BACKEND_AUTO)
+    {
+        for (backend = AES_GCM_BACKEND_COUNT - 1; !gcm_cpu_has(backend); backend--)
+            ;
+    }
+    else if (!gcm_cpu_has(backend))
+    {
+        return 0;
+    }
+
+    gcm_backend = backend;
+    return 1;
+}
+
+#ifdef AES_GCM_X86
+__attribute__((constructor))
+static void gcm_select_auto(void)
+{
+    crypto_aes256_gcm_select_backend(AES_GCM_BACKEND_AUTO);
+}
+#endif
+
+const char * crypto_aes256_gcm_backend_name(void)
+{
+    return backends[gcm_backend].name;
+}
+
+// x = GHASH of x and @data, the last block padded with zeros
+static void ghash(const aes_gcm_ctx * ctx, uint8_t * x, const uint8_t * data, uint32_t length)
+{
+    uint8_t last[BLOCK_SIZE];
+    uint32_t whole = length / BLOCK_SIZE;
+
+    backends[gcm_backend].ghash(ctx, x, data, whole);
+    if (length % BLOCK_SIZE)
+    {
+        memset(last, 0, sizeof(last));
+        memmove(last, data + whole * BLOCK_SIZE, length % BLOCK_SIZE);
+        backends[gcm_backend].ghash(ctx, x, last, 1);
+    }
+}
+
+// XOR @data with the key stream from counter block @ctr onwards
+static void gcm_ctr(const aes_gcm_ctx * ctx, const uint8_t * ctr, uint8_t * data, uint32_t length)
+{
+    uint8_t stream[CTR_BLOCKS * BLOCK_SIZE];
+    uint32_t counter = (uint32_t)ctr[12] << 24 | (uint32_t)ctr[13] << 16 | (uint32_t)ctr[14] << 8 | ctr[15];
+    uint32_t n, i;
+
+    while (length > 0)
+    {
+        n = length < sizeof(stream) ? length : sizeof(stream);
+
+        for (i = 0; i < n; i += BLOCK_SIZE)
+        {
+            memmove(stream + i, ctr, 12);
+            stream[i + 12] = (uint8_t)(counter >> 24);
+            stream[i + 13] = (uint8_t)(counter >> 16);
+            stream[i + 14] = (uint8_t)(counter >> 8);
+            stream[i + 15] = (uint8_t)counter;
+            counter++;
+        }
+        aes_encrypt_blocks(&ctx->aes, stream, (n + BLOCK_SIZE - 1) & ~(BLOCK_SIZE - 1));
+
+        for (i = 0; i < n; i++)
+        {
+            data[i] ^= stream[i];
+        }
+        data += n;
+        length -= n;
+    }
+
+    memset(stream, 0, sizeof(stream));
+}
+
+// GHASH of @aad and @data with their bit lengths, masked with E(J0)
+static void gcm_tag(const aes_gcm_ctx * ctx, const uint8_t * j0,
+                    const uint8_t * aad, uint32_t aad_len,
+                    const uint8_t * data, uint32_t length, uint8_t * tag)
+{
+    uint8_t x[BLOCK_SIZE], lengths[BLOCK_SIZE];
+    int i;
+
+    memset(x, 0, sizeof(x));
+    ghash(ctx, x, aad, aad_len);
+    ghash(ctx, x, data, length);
+    put64(lengths, (uint64_t)aad_len * 8);
+    put64(lengths + 8, (uint64_t)length * 8);
+    ghash(ctx, x, lengths, BLOCK_SIZE);
+
+    memmove(tag, j0, BLOCK_SIZE);
+    aes_encrypt_blocks(&ctx->aes, tag, BLOCK_SIZE);
+    for (i = 0; i < BLOCK_SIZE; i++)
+    {
+        tag[i] ^= x[i];
+    }
+}
+
+// J0 = IV || 0^31 || 1 and the first data counter block after it
+static void gcm_counters(const uint8_t * iv, uint8_t * j0, uint8_t * ctr)
+{
+    memmove(j0, iv, AES_GCM_IV_SIZE);
+    j0[12] = 0;
+    j0[13] = 0;
+    j0[14] = 0;
+    j0[15] = 1;
+    memmove(ctr, j0, BLOCK_SIZE);
+    ctr[15] = 2;
 }
 
+void crypto_aes256_gcm_init(aes_gcm_ctx * ctx, const uint8_t * key)
+{
+#ifdef CRYPTO_AES_HOST
+    aes256_init(&ctx->aes, key);
+#else
+    AES_init_ctx(&ctx->aes, key);
 #endif
+    memset(ctx->h, 0, sizeof(ctx->h));
+    aes_encrypt_blocks(&ctx->aes, ctx->h, BLOCK_SIZE);
+    ghash_table_init(ctx);
+}
+
+void crypto_aes256_gcm_encrypt(aes_gcm_ctx * ctx, const uint8_t * iv,
+                               const uint8_t * aad, uint32_t aad_len,
+                               uint8_t * data, uint32_t length, uint8_t * tag)
+{
+    uint8_t j0[BLOCK_SIZE], ctr[BLOCK_SIZE];
+
+    gcm_counters(iv, j0, ctr);
+    gcm_ctr(ctx, ctr, data, length);
+    gcm_tag(ctx, j0, aad, aad_len, data, length, tag);
+}
+
+int8_t crypto_aes256_gcm_decrypt(aes_gcm_ctx * ctx, const uint8_t * iv,
+                                 const uint8_t * aad, uint32_t aad_len,
+                                 uint8_t * data, uint32_t length, const uint8_t * tag)
+{
+    uint8_t j0[BLOCK_SIZE], ctr[BLOCK_SIZE], expect[AES_GCM_TAG_SIZE];
+    uint8_t diff = 0;
+    int i;
+
+    gcm_counters(iv, j0, ctr);
+    gcm_tag(ctx, j0, aad, aad_len, data, length, expect);
+
+    for (i = 0; i < AES_GCM_TAG_SIZE; i++)
+    {
+        diff |= expect[i] ^ tag[i];
+    }
+    if (diff != 0)
+    {
+        return -1;
+    }
+
+    gcm_ctr(ctx, ctr, data, length);
+    return 0;
+}
@@ -0,0 +1,55 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+
+// AES-256-GCM (NIST SP 800-38D) with 96-bit nonces and 16 byte tags.
+// GHASH uses 4-bit tables everywhere, or PCLMULQDQ on x86 hosts.
+#ifndef _AES_GCM_H
+#define _AES_GCM_H
+
+#include <stdint.h>
+
+#include "crypto.h"
+
+#define AES_GCM_IV_SIZE             12
+#define AES_GCM_TAG_SIZE            16
+
+#define AES_GCM_BACKEND_AUTO        0
+#define AES_GCM_BACKEND_TABLE       1
+#define AES_GCM_BACKEND_PCLMUL      2
+#define AES_GCM_BACKEND_COUNT       3
+
+typedef struct
+{
+    crypto_aes_ctx aes;
+    uint8_t h[16];          // AES_K(0)
+    uint64_t hh[16];        // i * H for each 4-bit i, high and low halves
+    uint64_t hl[16];
+} aes_gcm_ctx;
+
+// Key with 32 bytes
+void crypto_aes256_gcm_init(aes_gcm_ctx * ctx, const uint8_t * key);
+
+// Encrypt @data in place and write the tag.  @aad is authenticated only.
+void crypto_aes256_gcm_encrypt(aes_gcm_ctx * ctx, const uint8_t * iv,
+                               const uint8_t * aad, uint32_t aad_len,
+                               uint8_t * data, uint32_t length, uint8_t * tag);
+
+// Check the tag, then decrypt @data in place.  Nothing is decrypted if the
+// tag does not match.
+// @return 0, or -1 on a bad tag
+int8_t crypto_aes256_gcm_decrypt(aes_gcm_ctx * ctx, const uint8_t * iv,
+                                 const uint8_t * aad, uint32_t aad_len,
+                                 uint8_t * data, uint32_t length, const uint8_t * tag);
+
+// Use @backend, or the fastest one the CPU supports for AES_GCM_BACKEND_AUTO,
+// which is also picked when the program loads.  For tests and benchmarks: it
+// must not run while another thread is using GCM.
+// @return 1, or 0 if the backend is not available here
+int crypto_aes256_gcm_select_backend(int backend);
+const char * crypto_aes256_gcm_backend_name(void);
+
+#endif
@@ -0,0 +1,146 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+
+// AES-256 test cases 13 to 16 of McGrew and Viega, "The Galois/Counter
+// Mode of Operation", the ones with 96-bit IVs, run with every GHASH
+// backend the CPU supports.
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "aes_gcm.h"
+
+#define check(x) do { if (!(x)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #x); exit(1); } } while (0)
+
+#define K15 "\xfe\xff\xe9\x92\x86\x65\x73\x1c\x6d\x6a\x8f\x94\x67\x30\x83\x08" \
+            "\xfe\xff\xe9\x92\x86\x65\x73\x1c\x6d\x6a\x8f\x94\x67\x30\x83\x08"
+#define IV15 "\xca\xfe\xba\xbe\xfa\xce\xdb\xad\xde\xca\xf8\x88"
+#define P15 "\xd9\x31\x32\x25\xf8\x84\x06\xe5\xa5\x59\x09\xc5\xaf\xf5\x26\x9a" \
+            "\x86\xa7\xa9\x53\x15\x34\xf7\xda\x2e\x4c\x30\x3d\x8a\x31\x8a\x72" \
+            "\x1c\x3c\x0c\x95\x95\x68\x09\x53\x2f\xcf\x0e\x24\x49\xa6\xb5\x25" \
+            "\xb1\x6a\xed\xf5\xaa\x0d\xe6\x57\xba\x63\x7b\x39\x1a\xaf\xd2\x55"
+#define C15 "\x52\x2d\xc1\xf0\x99\x56\x7d\x07\xf4\x7f\x37\xa3\x2a\x84\x42\x7d" \
+            "\x64\x3a\x8c\xdc\xbf\xe5\xc0\xc9\x75\x98\xa2\xbd\x25\x55\xd1\xaa" \
+            "\x8c\xb0\x8e\x48\x59\x0d\xbb\x3d\xa7\xb0\x8b\x10\x56\x82\x88\x38" \
+            "\xc5\xf6\x1e\x63\x93\xba\x7a\x0a\xbc\xc9\xf6\x62\x89\x80\x15\xad"
+
+static const struct
+{
+    const char * key;
+    const char * iv;
+    const char * aad;
+    uint32_t aad_len;
+    const char * pt;
+    const char * ct;
+    uint32_t len;
+    const char * tag;
+} vectors[] = {
+    // 13
+    {
+        "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+        "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00",
+        "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00",
+        "", 0,
+        "", "", 0,
+        "\x53\x0f\x8a\xfb\xc7\x45\x36\xb9\xa9\x63\xb4\xf1\xc4\xcb\x73\x8b",
+    },
+    // 14
+    {
+        "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+        "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00",
+        "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00",
+        "", 0,
+        "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00",
+        "\xce\xa7\x40\x3d\x4d\x60\x6b\x6e\x07\x4e\xc5\xd3\xba\xf3\x9d\x18", 16,
+        "\xd0\xd1\xc8\xa7\x99\x99\x6b\xf0\x26\x5b\x98\xb5\xd4\x8a\xb9\x19",
+    },
+    // 15
+    {
+        K15, IV15,
+        "", 0,
+        P15, C15, 64,
+        "\xb0\x94\xda\xc5\xd9\x34\x71\xbd\xec\x1a\x50\x22\x70\xe3\xcc\x6c",
+    },
+    // 16, same as 15 but with AAD and a partial last block
+    {
+        K15, IV15,
+        "\xfe\xed\xfa\xce\xde\xad\xbe\xef\xfe\xed\xfa\xce\xde\xad\xbe\xef\xab\xad\xda\xd2", 20,
+        P15, C15, 60,
+        "\x76\xfc\x6e\xce\x0f\x4e\x17\x68\xcd\xdf\x88\x53\xbb\x2d\x55\x1b",
+    },
+};
+
+static void test_vectors()
+{
+    aes_gcm_ctx ctx;
+    uint8_t buf[64], tag[16];
+    unsigned int i;
+
+    for (i = 0; i < sizeof(vectors)/sizeof(vectors[0]); i++)
+    {
+        crypto_aes256_gcm_init(&ctx, (const uint8_t *)vectors[i].key);
+
+        memmove(buf, vectors[i].pt, vectors[i].len);
+        crypto_aes256_gcm_encrypt(&ctx, (const uint8_t *)vectors[i].iv,
+                                  (const uint8_t *)vectors[i].aad, vectors[i].aad_len,
+                                  buf, vectors[i].len, tag);
+        check(memcmp(buf, vectors[i].ct, vectors[i].len) == 0);
+        check(memcmp(tag, vectors[i].tag, 16) == 0);
+
+        check(crypto_aes256_gcm_decrypt(&ctx, (const uint8_t *)vectors[i].iv,
+                                        (const uint8_t *)vectors[i].aad, vectors[i].aad_len,
+                                        buf, vectors[i].len, tag) == 0);
+        check(memcmp(buf, vectors[i].pt, vectors[i].len) == 0);
+    }
+}
+
+// A flipped bit anywhere fails, and leaves the ciphertext alone
+static void test_forgery()
+{
+    aes_gcm_ctx ctx;
+    uint8_t buf[60], aad[20], tag[16];
+    const uint8_t * iv = (const uint8_t *)IV15;
+
+    crypto_aes256_gcm_init(&ctx, (const uint8_t *)K15);
+    memmove(aad, vectors[3].aad, sizeof(aad));
+    memmove(tag, vectors[3].tag, sizeof(tag));
+
+    memmove(buf, C15, sizeof(buf));
+    buf[59] ^= 0x01;
+    check(crypto_aes256_gcm_decrypt(&ctx, iv, aad, sizeof(aad), buf, sizeof(buf), tag) == -1);
+    buf[59] ^= 0x01;
+    check(memcmp(buf, C15, sizeof(buf)) == 0);
+
+    aad[0] ^= 0x80;
+    check(crypto_aes256_gcm_decrypt(&ctx, iv, aad, sizeof(aad), buf, sizeof(buf), tag) == -1);
+    aad[0] ^= 0x80;
+
+    tag[15] ^= 0x01;
+    check(crypto_aes256_gcm_decrypt(&ctx, iv, aad, sizeof(aad), buf, sizeof(buf), tag) == -1);
+    tag[15] ^= 0x01;
+
+    check(crypto_aes256_gcm_decrypt(&ctx, iv, aad, sizeof(aad), buf, sizeof(buf), tag) == 0);
+    check(memcmp(buf, P15, sizeof(buf)) == 0);
+}
+
+int main(int argc, char * argv[])
+{
+    int backend;
+
+    for (backend = AES_GCM_BACKEND_TABLE; backend < AES_GCM_BACKEND_COUNT; backend++)
+    {
+        if (!crypto_aes256_gcm_select_backend(backend))
+        {
+            continue;
+        }
+        test_vectors();
+        test_forgery();
+        printf("aes-gcm: all tests passed with %s\n", crypto_aes256_gcm_backend_name());
+    }
+    return 0;
+}
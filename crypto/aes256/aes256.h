@@ -0,0 +1,57 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+
+// AES-256 for the host build, with AES-NI where the CPU has it and 32-bit
+// T-tables otherwise.  Round keys are expanded once per key and kept in
+// the context, so a context can be copied instead of keyed again.
+#ifndef _AES256_H
+#define _AES256_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define AES256_BLOCK_SIZE       16
+#define AES256_ROUNDS           14
+
+#define AES256_BACKEND_AUTO     0
+#define AES256_BACKEND_PORTABLE 1
+#define AES256_BACKEND_AESNI    2
+#define AES256_BACKEND_COUNT    3
+
+typedef struct
+{
+    // Encryption round keys, first round first
+    uint8_t rk[(AES256_ROUNDS + 1) * AES256_BLOCK_SIZE];
+    // Round keys of the equivalent inverse cipher, last round first
+    uint8_t dk[(AES256_ROUNDS + 1) * AES256_BLOCK_SIZE];
+    uint8_t iv[AES256_BLOCK_SIZE];
+} aes256_ctx;
+
+// Expand @key (32 bytes) and zero the IV
+void aes256_init(aes256_ctx * ctx, const uint8_t * key);
+void aes256_set_iv(aes256_ctx * ctx, const uint8_t * iv);
+
+void aes256_encrypt_block(const aes256_ctx * ctx, const uint8_t * in, uint8_t * out);
+void aes256_decrypt_block(const aes256_ctx * ctx, const uint8_t * in, uint8_t * out);
+
+// The whole blocks of @in, each on its own.  @in may be @out.
+void aes256_ecb_encrypt(const aes256_ctx * ctx, const uint8_t * in, uint8_t * out, size_t length);
+
+// CBC in place over the whole blocks of @buf.  The IV is left at the last
+// ciphertext block, so one message can be passed in pieces.
+void aes256_cbc_encrypt(aes256_ctx * ctx, uint8_t * buf, size_t length);
+void aes256_cbc_decrypt(aes256_ctx * ctx, uint8_t * buf, size_t length);
+
+// Use @backend, or the fastest one the CPU supports for AES256_BACKEND_AUTO,
+// which is also picked when the program loads.  Contexts stay valid across a
+// switch.  For tests and benchmarks: it must not run while another thread is
+// using AES.
+// @return 1, or 0 if the backend is not available here
+int aes256_select_backend(int backend);
+const char * aes256_backend_name(void);
+
+#endif
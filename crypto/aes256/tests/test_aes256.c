@@ -0,0 +1,118 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+
+// Known answers from FIPS-197 appendix C.3 and SP 800-38A F.2.5, run with
+// every backend the CPU supports.
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "aes256.h"
+
+#define check(x) do { if (!(x)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #x); exit(1); } } while (0)
+
+static const uint8_t * fips_key = (const uint8_t *)
+    "\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f"
+    "\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19\x1a\x1b\x1c\x1d\x1e\x1f";
+static const uint8_t * fips_pt = (const uint8_t *)
+    "\x00\x11\x22\x33\x44\x55\x66\x77\x88\x99\xaa\xbb\xcc\xdd\xee\xff";
+static const uint8_t * fips_ct = (const uint8_t *)
+    "\x8e\xa2\xb7\xca\x51\x67\x45\xbf\xea\xfc\x49\x90\x4b\x49\x60\x89";
+
+static const uint8_t * cbc_key = (const uint8_t *)
+    "\x60\x3d\xeb\x10\x15\xca\x71\xbe\x2b\x73\xae\xf0\x85\x7d\x77\x81"
+    "\x1f\x35\x2c\x07\x3b\x61\x08\xd7\x2d\x98\x10\xa3\x09\x14\xdf\xf4";
+static const uint8_t * cbc_iv = (const uint8_t *)
+    "\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e\x0f";
+static const uint8_t * cbc_pt = (const uint8_t *)
+    "\x6b\xc1\xbe\xe2\x2e\x40\x9f\x96\xe9\x3d\x7e\x11\x73\x93\x17\x2a"
+    "\xae\x2d\x8a\x57\x1e\x03\xac\x9c\x9e\xb7\x6f\xac\x45\xaf\x8e\x51"
+    "\x30\xc8\x1c\x46\xa3\x5c\xe4\x11\xe5\xfb\xc1\x19\x1a\x0a\x52\xef"
+    "\xf6\x9f\x24\x45\xdf\x4f\x9b\x17\xad\x2b\x41\x7b\xe6\x6c\x37\x10";
+static const uint8_t * cbc_ct = (const uint8_t *)
+    "\xf5\x8c\x4c\x04\xd6\xe5\xf1\xba\x77\x9e\xab\xfb\x5f\x7b\xfb\xd6"
+    "\x9c\xfc\x4e\x96\x7e\xdb\x80\x8d\x67\x9f\x77\x7b\xc6\x70\x2c\x7d"
+    "\x39\xf2\x33\x69\xa9\xd9\xba\xcf\xa5\x30\xe2\x63\x04\x23\x14\x61"
+    "\xb2\xeb\x05\xe2\xc3\x9b\xe9\xfc\xda\x6c\x19\x07\x8c\x6a\x9d\x1b";
+
+static void test_block()
+{
+    aes256_ctx ctx;
+    uint8_t buf[16];
+
+    aes256_init(&ctx, fips_key);
+    aes256_encrypt_block(&ctx, fips_pt, buf);
+    check(memcmp(buf, fips_ct, 16) == 0);
+    aes256_decrypt_block(&ctx, buf, buf);
+    check(memcmp(buf, fips_pt, 16) == 0);
+}
+
+// Enough blocks for the four wide path and the tail
+static void test_ecb()
+{
+    aes256_ctx ctx;
+    uint8_t buf[7 * 16];
+    int i;
+
+    aes256_init(&ctx, fips_key);
+    for (i = 0; i < 7; i++)
+    {
+        memmove(buf + i * 16, fips_pt, 16);
+    }
+    aes256_ecb_encrypt(&ctx, buf, buf, sizeof(buf));
+    for (i = 0; i < 7; i++)
+    {
+        check(memcmp(buf + i * 16, fips_ct, 16) == 0);
+    }
+}
+
+// Whole message, then split where the IV has to carry over
+static void test_cbc()
+{
+    aes256_ctx ctx, copy;
+    uint8_t buf[64];
+    size_t split;
+
+    aes256_init(&ctx, cbc_key);
+    copy = ctx;
+
+    for (split = 0; split <= 64; split += 16)
+    {
+        ctx = copy;
+        aes256_set_iv(&ctx, cbc_iv);
+        memmove(buf, cbc_pt, 64);
+        aes256_cbc_encrypt(&ctx, buf, split);
+        aes256_cbc_encrypt(&ctx, buf + split, 64 - split);
+        check(memcmp(buf, cbc_ct, 64) == 0);
+        check(memcmp(ctx.iv, cbc_ct + 48, 16) == 0);
+
+        aes256_set_iv(&ctx, cbc_iv);
+        aes256_cbc_decrypt(&ctx, buf, split);
+        aes256_cbc_decrypt(&ctx, buf + split, 64 - split);
+        check(memcmp(buf, cbc_pt, 64) == 0);
+        check(memcmp(ctx.iv, cbc_ct + 48, 16) == 0);
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    int backend;
+
+    for (backend = AES256_BACKEND_PORTABLE; backend < AES256_BACKEND_COUNT; backend++)
+    {
+        if (!aes256_select_backend(backend))
+        {
+            continue;
+        }
+        test_block();
+        test_ecb();
+        test_cbc();
+        printf("aes256: all tests passed with %s\n", aes256_backend_name());
+    }
+    return 0;
+}
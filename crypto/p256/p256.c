@@ -0,0 +1,264 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+
+// Fixed-base scalar multiplication with a Lim-Lee comb.  Points are in
+// homogeneous projective coordinates and use the complete formulas of
+// Renes, Costello and Batina (ePrint 2015/1060) for a = -3, so the point
+// at infinity and doublings need no special cases.  Table entries are
+// read by scanning the whole table.
+#include <string.h>
+
+#include "p256.h"
+#include "p256_field.h"
+#include "p256_table.h"
+
+#define COMB_SPACING    ((256 + P256_COMB_TEETH - 1) / P256_COMB_TEETH)
+
+typedef struct
+{
+    p256_int x, y, z;
+} p256_point;
+
+// Curve b in the Montgomery domain
+static const p256_int p256_b = P256_INT(0x29c4bddf, 0xd89cdf62, 0x78843090, 0xacf005cd,
+                                        0xf7212ed6, 0xe5a220ab, 0x04874834, 0xdc30061d);
+
+#define mul(r, a, b)    p256_mod_mul(r, a, b, &p256_p)
+#define add(r, a, b)    p256_mod_add(r, a, b, &p256_p)
+#define sub(r, a, b)    p256_mod_sub(r, a, b, &p256_p)
+
+// Algorithm 6 of the paper
+static void point_double(p256_point * r, const p256_point * p)
+{
+    p256_int t0, t1, t2, t3, x3, y3, z3;
+
+    mul(&t0, &p->x, &p->x);
+    mul(&t1, &p->y, &p->y);
+    mul(&t2, &p->z, &p->z);
+    mul(&t3, &p->x, &p->y);
+    add(&t3, &t3, &t3);
+    mul(&z3, &p->x, &p->z);
+    add(&z3, &z3, &z3);
+    mul(&y3, &p256_b, &t2);
+    sub(&y3, &y3, &z3);
+    add(&x3, &y3, &y3);
+    add(&y3, &x3, &y3);
+    sub(&x3, &t1, &y3);
+    add(&y3, &t1, &y3);
+    mul(&y3, &x3, &y3);
+    mul(&x3, &x3, &t3);
+    add(&t3, &t2, &t2);
+    add(&t2, &t2, &t3);
+    mul(&z3, &p256_b, &z3);
+    sub(&z3, &z3, &t2);
+    sub(&z3, &z3, &t0);
+    add(&t3, &z3, &z3);
+    add(&z3, &z3, &t3);
+    add(&t3, &t0, &t0);
+    add(&t0, &t3, &t0);
+    sub(&t0, &t0, &t2);
+    mul(&t0, &t0, &z3);
+    add(&y3, &y3, &t0);
+    mul(&t0, &p->y, &p->z);
+    add(&t0, &t0, &t0);
+    mul(&z3, &t0, &z3);
+    sub(&x3, &x3, &z3);
+    mul(&z3, &t0, &t1);
+    add(&z3, &z3, &z3);
+    add(&z3, &z3, &z3);
+
+    r->x = x3;
+    r->y = y3;
+    r->z = z3;
+}
+
+// Algorithm 5 of the paper, r = p + (x2, y2).  (x2, y2) must not be the
+// point at infinity.
+static void point_add_affine(p256_point * r, const p256_point * p, const p256_int * x2, const p256_int * y2)
+{
+    p256_int t0, t1, t2, t3, t4, x3, y3, z3;
+
+    mul(&t0, &p->x, x2);
+    mul(&t1, &p->y, y2);
+    add(&t3, x2, y2);
+    add(&t4, &p->x, &p->y);
+    mul(&t3, &t3, &t4);
+    add(&t4, &t0, &t1);
+    sub(&t3, &t3, &t4);
+    mul(&t4, y2, &p->z);
+    add(&t4, &t4, &p->y);
+    mul(&y3, x2, &p->z);
+    add(&y3, &y3, &p->x);
+    mul(&z3, &p256_b, &p->z);
+    sub(&x3, &y3, &z3);
+    add(&z3, &x3, &x3);
+    add(&x3, &x3, &z3);
+    sub(&z3, &t1, &x3);
+    add(&x3, &t1, &x3);
+    mul(&y3, &p256_b, &y3);
+    add(&t1, &p->z, &p->z);
+    add(&t2, &t1, &p->z);
+    sub(&y3, &y3, &t2);
+    sub(&y3, &y3, &t0);
+    add(&t1, &y3, &y3);
+    add(&y3, &t1, &y3);
+    add(&t1, &t0, &t0);
+    add(&t0, &t1, &t0);
+    sub(&t0, &t0, &t2);
+    mul(&t1, &t4, &y3);
+    mul(&t2, &t0, &y3);
+    mul(&y3, &x3, &z3);
+    add(&y3, &y3, &t2);
+    mul(&x3, &t3, &x3);
+    sub(&x3, &x3, &t1);
+    mul(&z3, &t4, &z3);
+    mul(&t1, &t3, &t0);
+    add(&z3, &z3, &t1);
+
+    r->x = x3;
+    r->y = y3;
+    r->z = z3;
+}
+
+// Table entry @idx - 1, read without revealing idx
+static void comb_lookup(p256_int * x, p256_int * y, unsigned int idx)
+{
+    p256_limb mask;
+    unsigned int i;
+
+    memset(x, 0, sizeof(*x));
+    memset(y, 0, sizeof(*y));
+    for (i = 1; i < (1u << P256_COMB_TEETH); i++)
+    {
+        // All ones when i == idx
+        mask = (p256_limb)0 - (p256_limb)(((i ^ idx) - 1) >> (sizeof(unsigned int) * 8 - 1));
+        p256_int_cmov(x, &p256_comb_table[i - 1][0], mask);
+        p256_int_cmov(y, &p256_comb_table[i - 1][1], mask);
+    }
+}
+
+static unsigned int scalar_bit(const p256_int * k, unsigned int bit)
+{
+    if (bit >= 256)
+    {
+        return 0;
+    }
+    return (k->v[bit / P256_LIMB_BITS] >> (bit % P256_LIMB_BITS)) & 1;
+}
+
+// r = k * G as affine x, y in the Montgomery domain.  k must be in [1, n - 1].
+static void comb_mult(p256_int * x, p256_int * y, const p256_int * k)
+{
+    p256_point r, sum;
+    p256_int tx, ty, zinv;
+    unsigned int idx;
+    int i, t;
+
+    // Point at infinity
+    memset(&r, 0, sizeof(r));
+    r.y = p256_p.one;
+
+    for (i = COMB_SPACING - 1; i >= 0; i--)
+    {
+        point_double(&r, &r);
+
+        idx = 0;
+        for (t = 0; t < P256_COMB_TEETH; t++)
+        {
+            idx |= scalar_bit(k, t * COMB_SPACING + i) << t;
+        }
+
+        // Column of zeros: add anyway and keep the old point
+        comb_lookup(&tx, &ty, idx);
+        point_add_affine(&sum, &r, &tx, &ty);
+        idx = (idx | (0u - idx)) >> (sizeof(unsigned int) * 8 - 1);
+        p256_int_cmov(&r.x, &sum.x, (p256_limb)0 - idx);
+        p256_int_cmov(&r.y, &sum.y, (p256_limb)0 - idx);
+        p256_int_cmov(&r.z, &sum.z, (p256_limb)0 - idx);
+    }
+
+    p256_mod_inv(&zinv, &r.z, &p256_p);
+    mul(x, &r.x, &zinv);
+    mul(y, &r.y, &zinv);
+}
+
+// All ones if k is in [1, n - 1]
+static p256_limb scalar_valid(const p256_int * k)
+{
+    return ~p256_int_is_zero(k) & p256_int_lt(k, &p256_n.m);
+}
+
+int p256_base_mult(const uint8_t * priv, uint8_t * pub)
+{
+    p256_int d, x, y;
+
+    p256_int_from_bytes(&d, priv);
+    if (!scalar_valid(&d))
+    {
+        return 0;
+    }
+
+    comb_mult(&x, &y, &d);
+    p256_mod_from_mont(&x, &x, &p256_p);
+    p256_mod_from_mont(&y, &y, &p256_p);
+    p256_int_to_bytes(pub, &x);
+    p256_int_to_bytes(pub + 32, &y);
+    return 1;
+}
+
+int p256_sign(const uint8_t * priv, const uint8_t * hash, unsigned int hashlen,
+              const uint8_t * k, uint8_t * sig)
+{
+    uint8_t buf[32];
+    p256_int kk, x, y, r, s, e, d;
+
+    p256_int_from_bytes(&kk, k);
+    if (!scalar_valid(&kk))
+    {
+        return 0;
+    }
+
+    // r = x(kG) mod n
+    comb_mult(&x, &y, &kk);
+    p256_mod_from_mont(&x, &x, &p256_p);
+    p256_mod_to_mont(&r, &x, &p256_n);
+    p256_mod_from_mont(&x, &r, &p256_n);
+    if (p256_int_is_zero(&x))
+    {
+        return 0;
+    }
+    p256_int_to_bytes(sig, &x);
+
+    // e is the leftmost 256 bits of the hash
+    if (hashlen > 32)
+    {
+        hashlen = 32;
+    }
+    memset(buf, 0, sizeof(buf));
+    memmove(buf + 32 - hashlen, hash, hashlen);
+    p256_int_from_bytes(&e, buf);
+    p256_int_from_bytes(&d, priv);
+
+    // s = (e + r * d) / k mod n
+    p256_mod_to_mont(&e, &e, &p256_n);
+    p256_mod_to_mont(&d, &d, &p256_n);
+    p256_mod_to_mont(&kk, &kk, &p256_n);
+    p256_mod_mul(&s, &r, &d, &p256_n);
+    p256_mod_add(&s, &s, &e, &p256_n);
+    p256_mod_inv(&kk, &kk, &p256_n);
+    p256_mod_mul(&s, &s, &kk, &p256_n);
+    p256_mod_from_mont(&s, &s, &p256_n);
+    if (p256_int_is_zero(&s))
+    {
+        return 0;
+    }
+    p256_int_to_bytes(sig + 32, &s);
+
+    memset(&d, 0, sizeof(d));
+    memset(&kk, 0, sizeof(kk));
+    return 1;
+}
@@ -0,0 +1,39 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+
+// Multiples of the P-256 generator from a precomputed comb, for key
+// generation and ECDSA signing.  Scalars, keys and coordinates are 32 byte
+// big-endian numbers, like micro-ecc's.
+#ifndef _P256_H
+#define _P256_H
+
+#include <stdint.h>
+
+// The comb table holds 2^P256_COMB_TEETH - 1 points of 64 bytes, and a
+// multiplication takes ceil(256 / P256_COMB_TEETH) doublings and additions.
+// Tables for 5 (2 KB) and 8 (16 KB) teeth are in p256_table.h.
+#ifndef P256_COMB_TEETH
+#define P256_COMB_TEETH     5
+#endif
+
+// pub = x || y of priv * G.
+// @return 1, or 0 if priv is not in [1, n - 1]
+int p256_base_mult(const uint8_t * priv, uint8_t * pub);
+
+// ECDSA signature r || s of @hash with the nonce @k.
+// @return 1, or 0 if k is not in [1, n - 1] or r or s came out zero.
+// Try again with another k then.
+int p256_sign(const uint8_t * priv, const uint8_t * hash, unsigned int hashlen,
+              const uint8_t * k, uint8_t * sig);
+
+// p256_sign with the RFC 6979 nonce for @priv and @hash, from HMAC-DRBG
+// with SHA-256.  The same key and hash always give the same signature.
+// @return 1, or 0 if priv is not in [1, n - 1]
+int p256_sign_deterministic(const uint8_t * priv, const uint8_t * hash, unsigned int hashlen,
+                            uint8_t * sig);
+
+#endif
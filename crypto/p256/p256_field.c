@@ -0,0 +1,333 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+
+// Portable word-by-word Montgomery arithmetic, with a multiplication mod p
+// unrolled for 64-bit limbs.  Nothing branches on or indexes memory by
+// secret data.
+#include <string.h>
+
+#include "p256_field.h"
+
+#if P256_LIMB_BITS == 64 && defined(__GNUC__) && defined(__x86_64__)
+#define P256_X86_64
+#endif
+
+const p256_mod p256_p = {
+    P256_INT(0xffffffff, 0xffffffff, 0xffffffff, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0xffffffff),
+    P256_INT(0x00000003, 0x00000000, 0xffffffff, 0xfffffffb, 0xfffffffe, 0xffffffff, 0xfffffffd, 0x00000004),
+    P256_INT(0x00000001, 0x00000000, 0x00000000, 0xffffffff, 0xffffffff, 0xffffffff, 0xfffffffe, 0x00000000),
+    0x00000001,
+};
+
+const p256_mod p256_n = {
+    P256_INT(0xfc632551, 0xf3b9cac2, 0xa7179e84, 0xbce6faad, 0xffffffff, 0xffffffff, 0x00000000, 0xffffffff),
+    P256_INT(0xbe79eea2, 0x83244c95, 0x49bd6fa6, 0x4699799c, 0x2b6bec59, 0x2845b239, 0xf3d95620, 0x66e12d94),
+    P256_INT(0x039cdaaf, 0x0c46353d, 0x58e8617b, 0x43190552, 0x00000000, 0x00000000, 0xffffffff, 0x00000000),
+#if P256_LIMB_BITS == 64
+    0xccd1c8aaee00bc4f,
+#else
+    0xee00bc4f,
+#endif
+};
+
+// r = t - m if t (with carry limb @hi) is at least m, else t
+static void mod_reduce_once(p256_int * r, const p256_limb * t, p256_limb hi, const p256_mod * m)
+{
+    p256_int d;
+    p256_dlimb diff;
+    p256_limb borrow = 0, keep;
+    int i;
+
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        diff = (p256_dlimb)t[i] - m->m.v[i] - borrow;
+        d.v[i] = (p256_limb)diff;
+        borrow = (p256_limb)(diff >> P256_LIMB_BITS) & 1;
+    }
+
+    // t < m only if the subtraction borrowed out of the carry limb too
+    keep = (p256_limb)0 - (borrow & ~hi & 1);
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        r->v[i] = (t[i] & keep) | (d.v[i] & ~keep);
+    }
+}
+
+static void mod_mul_generic(p256_int * r, const p256_int * a, const p256_int * b, const p256_mod * m)
+{
+    p256_limb t[P256_LIMBS + 2];
+    p256_dlimb acc;
+    p256_limb u;
+    int i, j;
+
+    memset(t, 0, sizeof(t));
+
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        // t += a * b[i]
+        acc = 0;
+        for (j = 0; j < P256_LIMBS; j++)
+        {
+            acc = (p256_dlimb)a->v[j] * b->v[i] + t[j] + (acc >> P256_LIMB_BITS);
+            t[j] = (p256_limb)acc;
+        }
+        acc = (p256_dlimb)t[P256_LIMBS] + (acc >> P256_LIMB_BITS);
+        t[P256_LIMBS] = (p256_limb)acc;
+        t[P256_LIMBS + 1] = (p256_limb)(acc >> P256_LIMB_BITS);
+
+        // t = (t + u * m) / 2^P256_LIMB_BITS
+        u = t[0] * m->m0inv;
+        acc = (p256_dlimb)u * m->m.v[0] + t[0];
+        for (j = 1; j < P256_LIMBS; j++)
+        {
+            acc = (p256_dlimb)u * m->m.v[j] + t[j] + (acc >> P256_LIMB_BITS);
+            t[j - 1] = (p256_limb)acc;
+        }
+        acc = (p256_dlimb)t[P256_LIMBS] + (acc >> P256_LIMB_BITS);
+        t[P256_LIMBS - 1] = (p256_limb)acc;
+        t[P256_LIMBS] = t[P256_LIMBS + 1] + (p256_limb)(acc >> P256_LIMB_BITS);
+    }
+
+    mod_reduce_once(r, t, t[P256_LIMBS], m);
+}
+
+#if P256_LIMB_BITS == 64
+// Montgomery multiplication mod p with 4 limbs.  -p^-1 mod 2^64 is 1, so
+// each reduction multiplier is the low limb itself, and of p's limbs
+// 2^64 - 1, 2^32 - 1, 0, 2^64 - 2^32 + 1 only two need a multiply.
+static inline __attribute__((always_inline))
+void mod_mul_p_body(p256_int * r, const p256_int * a, const p256_int * b)
+{
+    const p256_limb * x = a->v;
+    p256_limb t[P256_LIMBS + 1];
+    p256_limb t0 = 0, t1 = 0, t2 = 0, t3 = 0, t4 = 0, t5, y;
+    p256_dlimb acc;
+    int i;
+
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        // t += a * b[i]
+        y = b->v[i];
+        acc = (p256_dlimb)x[0] * y + t0;
+        t0 = (p256_limb)acc;
+        acc = (p256_dlimb)x[1] * y + t1 + (acc >> 64);
+        t1 = (p256_limb)acc;
+        acc = (p256_dlimb)x[2] * y + t2 + (acc >> 64);
+        t2 = (p256_limb)acc;
+        acc = (p256_dlimb)x[3] * y + t3 + (acc >> 64);
+        t3 = (p256_limb)acc;
+        acc = (p256_dlimb)t4 + (acc >> 64);
+        t4 = (p256_limb)acc;
+        t5 = (p256_limb)(acc >> 64);
+
+        // t = (t + t0 * p) / 2^64.  t0 + t0 * (2^64 - 1) is t0 * 2^64,
+        // a carry of t0 into the next limb.
+        acc = (p256_dlimb)t0 * 0x00000000ffffffff + t1 + t0;
+        t1 = (p256_limb)acc;
+        acc = (p256_dlimb)t2 + (acc >> 64);
+        t2 = (p256_limb)acc;
+        acc = (p256_dlimb)t0 * 0xffffffff00000001 + t3 + (acc >> 64);
+        t3 = (p256_limb)acc;
+        acc = (p256_dlimb)t4 + (acc >> 64);
+        t0 = t1;
+        t1 = t2;
+        t2 = t3;
+        t3 = (p256_limb)acc;
+        t4 = t5 + (p256_limb)(acc >> 64);
+    }
+
+    t[0] = t0;
+    t[1] = t1;
+    t[2] = t2;
+    t[3] = t3;
+    mod_reduce_once(r, t, t4, &p256_p);
+}
+
+static void mod_mul_p(p256_int * r, const p256_int * a, const p256_int * b)
+{
+    mod_mul_p_body(r, a, b);
+}
+
+#ifdef P256_X86_64
+#include <cpuid.h>
+
+// Same code, with the compiler free to use mulx
+__attribute__((target("bmi2")))
+static void mod_mul_p_bmi2(p256_int * r, const p256_int * a, const p256_int * b)
+{
+    mod_mul_p_body(r, a, b);
+}
+
+static void mod_mul_p_select(p256_int * r, const p256_int * a, const p256_int * b);
+
+// Set on first use.  Racing threads all pick the same function.
+static void (*mod_mul_p_impl)(p256_int * r, const p256_int * a, const p256_int * b) = mod_mul_p_select;
+
+static void mod_mul_p_select(p256_int * r, const p256_int * a, const p256_int * b)
+{
+    unsigned int eax, ebx, ecx, edx;
+
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & (1 << 8)))
+    {
+        mod_mul_p_impl = mod_mul_p_bmi2;
+    }
+    else
+    {
+        mod_mul_p_impl = mod_mul_p;
+    }
+    mod_mul_p_impl(r, a, b);
+}
+#else
+#define mod_mul_p_impl      mod_mul_p
+#endif
+#endif
+
+void p256_mod_mul(p256_int * r, const p256_int * a, const p256_int * b, const p256_mod * m)
+{
+#if P256_LIMB_BITS == 64
+    if (m == &p256_p)
+    {
+        mod_mul_p_impl(r, a, b);
+        return;
+    }
+#endif
+    mod_mul_generic(r, a, b, m);
+}
+
+void p256_mod_add(p256_int * r, const p256_int * a, const p256_int * b, const p256_mod * m)
+{
+    p256_limb t[P256_LIMBS];
+    p256_dlimb acc = 0;
+    int i;
+
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        acc = (p256_dlimb)a->v[i] + b->v[i] + (acc >> P256_LIMB_BITS);
+        t[i] = (p256_limb)acc;
+    }
+    mod_reduce_once(r, t, (p256_limb)(acc >> P256_LIMB_BITS), m);
+}
+
+void p256_mod_sub(p256_int * r, const p256_int * a, const p256_int * b, const p256_mod * m)
+{
+    p256_dlimb diff, acc = 0;
+    p256_limb borrow = 0, mask;
+    int i;
+
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        diff = (p256_dlimb)a->v[i] - b->v[i] - borrow;
+        r->v[i] = (p256_limb)diff;
+        borrow = (p256_limb)(diff >> P256_LIMB_BITS) & 1;
+    }
+
+    // Add m back if it went negative
+    mask = (p256_limb)0 - borrow;
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        acc = (p256_dlimb)r->v[i] + (m->m.v[i] & mask) + (acc >> P256_LIMB_BITS);
+        r->v[i] = (p256_limb)acc;
+    }
+}
+
+void p256_mod_inv(p256_int * r, const p256_int * a, const p256_mod * m)
+{
+    p256_int e = m->m;
+    p256_int x = m->one;
+    int i;
+
+    // The exponent is public, the low limb of both moduli is above 2
+    e.v[0] -= 2;
+
+    for (i = 255; i >= 0; i--)
+    {
+        p256_mod_mul(&x, &x, &x, m);
+        if ((e.v[i / P256_LIMB_BITS] >> (i % P256_LIMB_BITS)) & 1)
+        {
+            p256_mod_mul(&x, &x, a, m);
+        }
+    }
+    *r = x;
+}
+
+void p256_mod_to_mont(p256_int * r, const p256_int * a, const p256_mod * m)
+{
+    p256_mod_mul(r, a, &m->rr, m);
+}
+
+void p256_mod_from_mont(p256_int * r, const p256_int * a, const p256_mod * m)
+{
+    p256_int one;
+
+    memset(&one, 0, sizeof(one));
+    one.v[0] = 1;
+    p256_mod_mul(r, a, &one, m);
+}
+
+void p256_int_from_bytes(p256_int * r, const uint8_t * b)
+{
+    int i, j;
+
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        r->v[i] = 0;
+        for (j = 0; j < P256_LIMB_BITS / 8; j++)
+        {
+            r->v[i] |= (p256_limb)b[31 - i * (P256_LIMB_BITS / 8) - j] << (j * 8);
+        }
+    }
+}
+
+void p256_int_to_bytes(uint8_t * b, const p256_int * a)
+{
+    int i, j;
+
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        for (j = 0; j < P256_LIMB_BITS / 8; j++)
+        {
+            b[31 - i * (P256_LIMB_BITS / 8) - j] = (uint8_t)(a->v[i] >> (j * 8));
+        }
+    }
+}
+
+p256_limb p256_int_is_zero(const p256_int * a)
+{
+    p256_limb x = 0;
+    int i;
+
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        x |= a->v[i];
+    }
+    // Top bit of x - 1 is set only when x was zero
+    return (p256_limb)0 - ((~x & (x - 1)) >> (P256_LIMB_BITS - 1));
+}
+
+p256_limb p256_int_lt(const p256_int * a, const p256_int * b)
+{
+    p256_dlimb diff;
+    p256_limb borrow = 0;
+    int i;
+
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        diff = (p256_dlimb)a->v[i] - b->v[i] - borrow;
+        borrow = (p256_limb)(diff >> P256_LIMB_BITS) & 1;
+    }
+    return (p256_limb)0 - borrow;
+}
+
+void p256_int_cmov(p256_int * r, const p256_int * a, p256_limb mask)
+{
+    int i;
+
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        r->v[i] = (r->v[i] & ~mask) | (a->v[i] & mask);
+    }
+}
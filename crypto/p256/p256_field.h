@@ -0,0 +1,77 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+
+// Constant-time arithmetic on 256-bit integers modulo the P-256 field
+// prime p and group order n.  Elements are kept in the Montgomery domain,
+// x * 2^256 mod m, except where noted.
+#ifndef _P256_FIELD_H
+#define _P256_FIELD_H
+
+#include <stdint.h>
+
+// 64-bit limbs where the compiler has a 128-bit type (x86_64, aarch64),
+// else 32-bit.  Define P256_LIMB32 to force 32-bit limbs.
+#if defined(__SIZEOF_INT128__) && !defined(P256_LIMB32)
+typedef uint64_t p256_limb;
+__extension__ typedef unsigned __int128 p256_dlimb;
+#define P256_LIMB_BITS      64
+#define P256_LIMBS          4
+#else
+typedef uint32_t p256_limb;
+typedef uint64_t p256_dlimb;
+#define P256_LIMB_BITS      32
+#define P256_LIMBS          8
+#endif
+
+// Little-endian limbs
+typedef struct
+{
+    p256_limb v[P256_LIMBS];
+} p256_int;
+
+// Initializer from eight little-endian 32-bit words
+#if P256_LIMB_BITS == 64
+#define P256_INT(a0, a1, a2, a3, a4, a5, a6, a7)   {{ (a0) | (uint64_t)(a1) << 32, (a2) | (uint64_t)(a3) << 32, \
+                                                     (a4) | (uint64_t)(a5) << 32, (a6) | (uint64_t)(a7) << 32 }}
+#else
+#define P256_INT(a0, a1, a2, a3, a4, a5, a6, a7)   {{ a0, a1, a2, a3, a4, a5, a6, a7 }}
+#endif
+
+typedef struct
+{
+    p256_int m;
+    p256_int rr;            // 2^512 mod m
+    p256_int one;           // 2^256 mod m
+    p256_limb m0inv;        // -m^-1 mod 2^P256_LIMB_BITS
+} p256_mod;
+
+extern const p256_mod p256_p;
+extern const p256_mod p256_n;
+
+// r = a * b / 2^256 mod m.  a may be anything below 2^256, b must be below m.
+void p256_mod_mul(p256_int * r, const p256_int * a, const p256_int * b, const p256_mod * m);
+void p256_mod_add(p256_int * r, const p256_int * a, const p256_int * b, const p256_mod * m);
+void p256_mod_sub(p256_int * r, const p256_int * a, const p256_int * b, const p256_mod * m);
+// r = a^-1, by raising a to m - 2
+void p256_mod_inv(p256_int * r, const p256_int * a, const p256_mod * m);
+
+// Into and out of the Montgomery domain.  to_mont reduces any a below 2^256.
+void p256_mod_to_mont(p256_int * r, const p256_int * a, const p256_mod * m);
+void p256_mod_from_mont(p256_int * r, const p256_int * a, const p256_mod * m);
+
+// 32 big-endian bytes
+void p256_int_from_bytes(p256_int * r, const uint8_t * b);
+void p256_int_to_bytes(uint8_t * b, const p256_int * a);
+
+// All ones if true, else zero
+p256_limb p256_int_is_zero(const p256_int * a);
+p256_limb p256_int_lt(const p256_int * a, const p256_int * b);
+
+// r = a if mask is all ones, unchanged if it is zero
+void p256_int_cmov(p256_int * r, const p256_int * a, p256_limb mask);
+
+#endif
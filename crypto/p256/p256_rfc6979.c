@@ -0,0 +1,126 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+
+// Deterministic ECDSA nonces, RFC 6979 section 3.2 with HMAC-SHA-256.  The
+// HMAC-DRBG key changes only a few times per signature, so its padded
+// midstates are hashed once per key and copied for every HMAC under it.
+#include <string.h>
+
+#include "p256.h"
+#include "p256_field.h"
+#include "sha256.h"
+
+typedef struct
+{
+    SHA256_CTX inner, outer;
+} hmac_key;
+
+static void hmac_set_key(hmac_key * key, const uint8_t * k)
+{
+    uint8_t buf[64];
+    int i;
+
+    memset(buf, 0, sizeof(buf));
+    memmove(buf, k, 32);
+
+    for (i = 0; i < 64; i++)
+    {
+        buf[i] ^= 0x36;
+    }
+    sha256_init(&key->inner);
+    sha256_update(&key->inner, buf, 64);
+
+    for (i = 0; i < 64; i++)
+    {
+        buf[i] ^= 0x36 ^ 0x5c;
+    }
+    sha256_init(&key->outer);
+    sha256_update(&key->outer, buf, 64);
+
+    memset(buf, 0, sizeof(buf));
+}
+
+// out = HMAC_K(v || sep || x || h).  A negative @sep leaves out sep, and a
+// NULL @x leaves out x and h.  @out may be @v.
+static void hmac(const hmac_key * key, const uint8_t * v, int sep,
+                 const uint8_t * x, const uint8_t * h, uint8_t * out)
+{
+    SHA256_CTX ctx = key->inner;
+    uint8_t s = (uint8_t)sep;
+
+    sha256_update(&ctx, v, 32);
+    if (sep >= 0)
+    {
+        sha256_update(&ctx, &s, 1);
+    }
+    if (x != NULL)
+    {
+        sha256_update(&ctx, x, 32);
+        sha256_update(&ctx, h, 32);
+    }
+    sha256_final(&ctx, out);
+
+    ctx = key->outer;
+    sha256_update(&ctx, out, 32);
+    sha256_final(&ctx, out);
+
+    memset(&ctx, 0, sizeof(ctx));
+}
+
+int p256_sign_deterministic(const uint8_t * priv, const uint8_t * hash, unsigned int hashlen,
+                            uint8_t * sig)
+{
+    hmac_key key;
+    uint8_t k[32], v[32], h[32];
+    p256_int e;
+
+    // bits2octets(hash): the leftmost 256 bits, reduced mod n once
+    if (hashlen > 32)
+    {
+        hashlen = 32;
+    }
+    memset(h, 0, sizeof(h));
+    memmove(h + 32 - hashlen, hash, hashlen);
+    p256_int_from_bytes(&e, h);
+    p256_mod_sub(&e, &e, &p256_n.m, &p256_n);
+    p256_int_to_bytes(h, &e);
+
+    // An invalid key would make every candidate fail
+    p256_int_from_bytes(&e, priv);
+    if (p256_int_is_zero(&e) || !p256_int_lt(&e, &p256_n.m))
+    {
+        return 0;
+    }
+
+    memset(v, 0x01, sizeof(v));
+    memset(k, 0x00, sizeof(k));
+
+    hmac_set_key(&key, k);
+    hmac(&key, v, 0x00, priv, h, k);
+    hmac_set_key(&key, k);
+    hmac(&key, v, -1, NULL, NULL, v);
+    hmac(&key, v, 0x01, priv, h, k);
+    hmac_set_key(&key, k);
+    hmac(&key, v, -1, NULL, NULL, v);
+
+    // Out of range candidates, and the rare zero r or s, move on to the
+    // next one
+    hmac(&key, v, -1, NULL, NULL, v);
+    while (!p256_sign(priv, hash, hashlen, v, sig))
+    {
+        hmac(&key, v, 0x00, NULL, NULL, k);
+        hmac_set_key(&key, k);
+        hmac(&key, v, -1, NULL, NULL, v);
+        hmac(&key, v, -1, NULL, NULL, v);
+    }
+
+    memset(&key, 0, sizeof(key));
+    memset(&e, 0, sizeof(e));
+    memset(k, 0, sizeof(k));
+    memset(v, 0, sizeof(v));
+    return 1;
+}
@@ -0,0 +1,285 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+
+// Known answers for P-256 public keys and signatures.  The public keys
+// come from OpenSSL, and OpenSSL verifies every signature.  Montgomery
+// products at the edges of the limb arithmetic are checked separately, so
+// the 32-bit and 64-bit limb builds are held to the same answers.
+// Deterministic signatures are the RFC 6979 A.2.5 ones for SHA-256.
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "p256.h"
+#include "p256_field.h"
+
+#define check(x) do { if (!(x)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #x); exit(1); } } while (0)
+
+static const struct
+{
+    const char * priv;
+    const char * pub;
+    const char * k;
+    const char * hash;
+    const char * sig;
+} vectors[] = {
+    {
+        "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x01",
+        "\x6b\x17\xd1\xf2\xe1\x2c\x42\x47\xf8\xbc\xe6\xe5\x63\xa4\x40\xf2\x77\x03\x7d\x81\x2d\xeb\x33\xa0\xf4\xa1\x39\x45\xd8\x98\xc2\x96\x4f\xe3\x42\xe2\xfe\x1a\x7f\x9b\x8e\xe7\xeb\x4a\x7c\x0f\x9e\x16\x2b\xce\x33\x57\x6b\x31\x5e\xce\xcb\xb6\x40\x68\x37\xbf\x51\xf5",
+        "\x7a\xad\x5c\xdc\x27\xa8\xfd\xdd\xf8\x10\xc2\x95\x21\x14\xbd\xfa\xbd\x72\x52\x76\x30\xaf\x48\x3f\xb9\x83\x6a\x55\xb3\x0b\xea\xca",
+        "\xc5\x1a\x5d\x83\x50\x1d\x04\x72\xfa\x87\x01\xae\x0a\xe7\x0e\xb6\xb3\x90\x89\x99\x5b\xf0\x11\x25\xe2\xdc\x99\x0b\x5d\xd3\x03\xb2",
+        "\x27\x25\xc9\x5f\x0c\xc9\x05\x66\x8c\x07\x29\x38\x9b\xbb\x5a\xec\xcd\xe9\x2a\x1b\xf7\x58\x20\x0b\xf2\xa4\xec\xa1\xd4\xc6\x2b\x60\x55\x49\x3b\xc1\xb6\x98\x76\x27\xe2\xdc\xca\x28\xf1\x88\xbf\x62\x58\x53\x3f\x79\x8f\x40\x99\xc1\x98\x3b\xb5\xab\x94\x84\xfc\x91",
+    },
+    {
+        "\xff\xff\xff\xff\x00\x00\x00\x00\xff\xff\xff\xff\xff\xff\xff\xff\xbc\xe6\xfa\xad\xa7\x17\x9e\x84\xf3\xb9\xca\xc2\xfc\x63\x25\x50",
+        "\x6b\x17\xd1\xf2\xe1\x2c\x42\x47\xf8\xbc\xe6\xe5\x63\xa4\x40\xf2\x77\x03\x7d\x81\x2d\xeb\x33\xa0\xf4\xa1\x39\x45\xd8\x98\xc2\x96\xb0\x1c\xbd\x1c\x01\xe5\x80\x65\x71\x18\x14\xb5\x83\xf0\x61\xe9\xd4\x31\xcc\xa9\x94\xce\xa1\x31\x34\x49\xbf\x97\xc8\x40\xae\x0a",
+        "\x58\xf0\x70\xfd\x41\x38\xbf\xd0\x79\x7e\x74\x7b\xa7\xb6\xa2\x27\xb7\xa5\x67\x2c\xa3\x16\xc3\x64\x7c\x77\xa9\xc5\xd7\xc9\x64\x00",
+        "\xfb\x3a\xf4\x77\xe2\x37\xea\xf5\xdf\xa9\x01\xf2\x62\x5f\xa0\xd8\x98\x68\xe1\x60\xd4\x4f\xf6\xad\x4f\x76\x2d\xd3\x3a\x66\x09\x1f",
+        "\xd3\x15\x4d\x71\xf6\x60\xb4\xe4\xc4\x49\xa9\xe2\xbe\xd1\xd6\xef\x31\xa7\xe3\xd5\xe3\x7c\x2b\x52\xe2\x88\x0d\x87\xa8\xee\x44\x68\xad\xad\x21\xe5\xee\x92\x02\xa8\x45\x83\x49\x95\xf4\x2d\x0e\x27\x73\x2f\x2d\x61\x8d\x1c\x34\xce\xb9\x7f\x4c\xc1\x03\x5c\xb9\xeb",
+    },
+    {
+        "\x2d\x24\xd1\x20\x96\xc3\x96\xd0\x36\x40\x5f\x42\x88\x4b\x85\x68\x11\x91\xda\x87\x34\x71\x2d\xb8\x04\xd8\x97\x08\xd7\x0e\x8c\x7d",
+        "\x9b\x62\x68\x0c\x98\x27\x14\x18\xde\x2e\x40\x37\x87\xbb\xed\x2b\x60\xb9\x23\xaf\xbb\x91\x52\xc0\x49\xcc\xe9\xf3\x4c\x4f\x71\x72\xd9\x81\x72\xc4\xfd\xb2\x31\xea\x1b\xa1\x71\x0e\xbb\x7b\xba\x7a\x58\x5b\xd5\x43\xf4\x2f\xae\xdb\x44\xe2\x2f\x22\x3a\x7f\x98\x7b",
+        "\x8f\x7f\xcf\xc0\x89\xea\xb3\x5d\x68\x46\x74\x98\x69\x89\x1f\xe2\x79\x49\x80\xc0\x1f\x61\xea\x35\xbb\x23\x34\xc5\x9f\x26\x5b\xcc",
+        "\xe2\x46\xc3\x3a\xe3\xa8\x80\x49\xad\xad\x3c\xbc\x8b\x4b\xd4\xbe\x71\xcf\x37\x7d\xf1\x89\xf2\x7b\x9a\x7d\xf6\x3f\xbf\x7f\x9f\x00",
+        "\xb3\xe6\x3d\xee\xb8\xaa\x9f\xe6\xd8\x29\xfc\x9d\x23\x5a\x74\x09\x0b\xfe\xfe\x15\x6f\x21\x32\x71\x79\x03\xcb\x52\x83\x8d\xaf\x82\x68\x2d\xd3\xcb\x7e\x9a\xf7\x40\xa3\xf5\xf3\xd9\xb8\x28\x1c\x7d\x20\xc7\x2d\x03\x01\x3e\xee\xaa\x4c\xa3\x71\x8b\xa0\x06\x2d\x28",
+    },
+    {
+        "\x07\xf9\x75\x0f\x8c\x82\xc2\x81\x01\xa0\xa0\x8b\xab\x86\x84\xb7\xb0\x48\x06\x20\x05\xe4\x74\xb9\x8d\x85\xab\xd6\x15\xf3\xee\x0d",
+        "\xf6\xec\x9e\xea\x48\x9d\x2a\xc5\x8c\x86\xe7\x1b\x1d\x3c\x03\xd7\x44\xe2\x9b\xaa\x59\xd1\xe0\x50\x1c\xb9\x7e\x8f\x7e\xf2\x87\xe9\xe8\xe0\xfc\xf6\x84\x1c\x42\xf2\x29\x67\x92\xef\x1d\x87\xb6\xa9\xa8\x67\x6d\xca\xb4\x73\xed\xac\x88\x10\x25\x09\xb9\xe5\x91\x82",
+        "\xf9\xb1\xb5\x8e\x25\x2d\x05\x13\x9f\x1d\x24\x1d\x92\xa2\x2e\xb1\x73\xf4\xf5\x95\x36\xc1\x6c\xf2\x76\x2e\xde\x26\x2c\x4c\x52\x36",
+        "\xea\x20\xdb\xfe\x33\xf8\x98\xbe\x19\xe5\xde\x90\x45\xd3\xf8\x26\x2b\x3e\xde\xfb\x1f\x3c\xcf\x71\x9f\x50\xc3\xb8\xad\x43\x79\x3a",
+        "\x42\x6e\xfa\x87\x57\x77\xb9\xd8\xeb\x66\xf4\xf2\xc7\xa7\x81\x27\xc5\xd1\x11\x3e\xc1\x95\xdf\xa3\x99\xd9\x02\x7e\xe7\xa6\x6b\x98\xbb\x55\x2d\x81\x9e\x89\xac\x94\xd8\xed\xfb\xb6\x00\x27\x32\x0a\xa8\x88\xed\x21\xef\x95\x00\x1b\xc4\x2a\x4d\xa6\x87\x2d\x00\x23",
+    },
+};
+
+// The group order n
+static const uint8_t order[32] =
+    "\xff\xff\xff\xff\x00\x00\x00\x00\xff\xff\xff\xff\xff\xff\xff\xff"
+    "\xbc\xe6\xfa\xad\xa7\x17\x9e\x84\xf3\xb9\xca\xc2\xfc\x63\x25\x51";
+
+// r = a * b / 2^256 mod m
+static const struct
+{
+    const p256_mod * m;
+    const char * a;
+    const char * b;
+    const char * r;
+} products[] = {
+    {
+        &p256_p,
+        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff",
+        "\xff\xff\xff\xff\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xfe",
+        "\xff\xff\xff\xfe\x00\x00\x00\x03\xff\xff\xff\xfd\x00\x00\x00\x02\x00\x00\x00\x01\xff\xff\xff\xfe\x00\x00\x00\x02\xff\xff\xff\xff",
+    },
+    {
+        &p256_p,
+        "\xff\xff\xff\xff\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xfe",
+        "\xff\xff\xff\xff\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xfe",
+        "\xff\xff\xff\xfe\x00\x00\x00\x03\xff\xff\xff\xfd\x00\x00\x00\x02\x00\x00\x00\x01\xff\xff\xff\xfe\x00\x00\x00\x03\x00\x00\x00\x00",
+    },
+    {
+        &p256_p,
+        "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x01",
+        "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x01",
+        "\xff\xff\xff\xfe\x00\x00\x00\x03\xff\xff\xff\xfd\x00\x00\x00\x02\x00\x00\x00\x01\xff\xff\xff\xfe\x00\x00\x00\x03\x00\x00\x00\x00",
+    },
+    {
+        &p256_p,
+        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff",
+        "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x01",
+        "\x00\x00\x00\x00\xff\xff\xff\xfd\x00\x00\x00\x02\xff\xff\xff\xfd\xff\xff\xff\xff\x00\x00\x00\x01\xff\xff\xff\xfd\x00\x00\x00\x00",
+    },
+    {
+        &p256_p,
+        "\xff\xff\xff\xff\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff",
+        "\xff\xff\xff\xff\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xfe",
+        "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00",
+    },
+    {
+        &p256_p,
+        "\x01\x7f\x9e\xe6\x72\x5e\xd0\x9d\x3a\x05\x62\xd5\x6a\xbd\x68\x5a\x48\xf1\x65\xd5\x7b\x00\xc7\xf4\x78\x1e\xf8\x6f\x5c\x8c\xc1\xab",
+        "\x02\x97\xc5\xe5\x38\xf1\x2d\x92\xa2\x8f\x17\xd8\x3c\xe4\x4e\x27\x42\x44\x58\xb6\xb6\x04\x31\x06\xa8\x5f\x68\xb6\xda\xa8\xb2\xa6",
+        "\x46\xb2\x31\x79\x33\x21\x5f\x0a\x83\xa0\x47\xcc\x50\x63\xa1\x19\x4f\xab\x93\x62\x7f\x95\x97\x7e\x1a\x7b\x71\x3c\x07\xe9\xb7\x78",
+    },
+    {
+        &p256_p,
+        "\x5c\x9d\xc8\xb6\x4f\x4e\x68\xe5\xc8\x5b\xd7\x8d\x39\x6e\x0d\x55\xfc\x45\x22\x8f\x4b\xd5\x71\xb0\xb4\x1b\x56\x69\xa0\x72\x9b\x23",
+        "\xa4\x9d\x1c\xe2\x84\x49\x48\xa8\x6c\x51\xce\x92\x7e\x89\xf9\x18\x59\x08\x25\x51\x16\x00\x31\x4a\xc9\xae\xe9\xcf\x6b\x97\x8d\x7d",
+        "\x60\xef\xe5\x7a\x8b\x86\x08\x50\x94\x08\x6d\xbf\x3f\xad\xe3\xf8\xbf\x58\x80\x92\xf7\x29\xee\x74\x62\xa2\xd8\xa9\x08\xff\x94\xbc",
+    },
+    {
+        &p256_p,
+        "\xf9\x50\x7c\x87\x48\x65\x80\x79\x0b\x44\x04\x5f\x94\x29\x52\x3c\x4b\x03\x7d\x52\x90\x09\x77\xa9\xf2\xc9\x43\x86\x2c\x19\x9b\xd3",
+        "\x7d\x69\x33\xb9\x3c\x1b\xe0\xd0\x5f\x81\x63\x9e\x85\xfb\xc0\x58\x01\x95\x20\x61\xca\x53\x25\x51\xff\xfc\x34\x36\xd5\x23\x58\x3b",
+        "\x7e\xd3\x8f\x87\xa0\xa0\xf0\xc5\xaa\xec\xc8\x1a\x9c\xef\x74\x59\x51\x9a\x1d\x82\x18\x17\x7d\xee\x59\x9e\x4c\xa2\x64\xff\x73\x38",
+    },
+    {
+        &p256_n,
+        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff",
+        "\xff\xff\xff\xff\x00\x00\x00\x00\xff\xff\xff\xff\xff\xff\xff\xff\xbc\xe6\xfa\xad\xa7\x17\x9e\x84\xf3\xb9\xca\xc2\xfc\x63\x25\x50",
+        "\x60\xd0\x66\x33\x49\x05\xc1\xe9\x07\xf8\xb6\x04\x1e\x60\x77\x25\xba\xde\xf3\xe2\x43\x56\x6f\xaf\xce\x1b\xc8\xf7\x9c\x19\x7c\x78",
+    },
+    {
+        &p256_n,
+        "\xff\xff\xff\xff\x00\x00\x00\x00\xff\xff\xff\xff\xff\xff\xff\xff\xbc\xe6\xfa\xad\xa7\x17\x9e\x84\xf3\xb9\xca\xc2\xfc\x63\x25\x50",
+        "\xff\xff\xff\xff\x00\x00\x00\x00\xff\xff\xff\xff\xff\xff\xff\xff\xbc\xe6\xfa\xad\xa7\x17\x9e\x84\xf3\xb9\xca\xc2\xfc\x63\x25\x50",
+        "\x60\xd0\x66\x33\x49\x05\xc1\xe9\x07\xf8\xb6\x04\x1e\x60\x77\x25\xba\xde\xf3\xe2\x43\x56\x6f\xaf\xce\x1b\xc8\xf7\x9c\x19\x7c\x79",
+    },
+    {
+        &p256_n,
+        "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x01",
+        "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x01",
+        "\x60\xd0\x66\x33\x49\x05\xc1\xe9\x07\xf8\xb6\x04\x1e\x60\x77\x25\xba\xde\xf3\xe2\x43\x56\x6f\xaf\xce\x1b\xc8\xf7\x9c\x19\x7c\x79",
+    },
+    {
+        &p256_n,
+        "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff",
+        "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x01",
+        "\x9f\x2f\x99\xcb\xb6\xfa\x3e\x17\xf8\x07\x49\xfb\xe1\x9f\x88\xda\x02\x08\x06\xcb\x63\xc1\x2e\xd5\x25\x9e\x01\xcb\x60\x49\xa8\xd9",
+    },
+    {
+        &p256_n,
+        "\xff\xff\xff\xff\x00\x00\x00\x00\xff\xff\xff\xff\xff\xff\xff\xff\xbc\xe6\xfa\xad\xa7\x17\x9e\x84\xf3\xb9\xca\xc2\xfc\x63\x25\x51",
+        "\xff\xff\xff\xff\x00\x00\x00\x00\xff\xff\xff\xff\xff\xff\xff\xff\xbc\xe6\xfa\xad\xa7\x17\x9e\x84\xf3\xb9\xca\xc2\xfc\x63\x25\x50",
+        "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00",
+    },
+    {
+        &p256_n,
+        "\x7d\xd5\x09\x4c\xdd\x42\x40\xc6\xd7\xa9\x62\xc6\x71\xf4\x36\x0e\x03\x58\x68\xe5\xd9\x8c\x2b\x45\xba\x56\x81\x34\x7b\x74\xfc\xfa",
+        "\xd5\x3c\xea\x17\x74\x4a\xcd\xa7\x1f\x78\xff\x04\xcb\xb5\x81\x1f\xb2\xf1\xa7\x09\x79\x9e\xb9\xf8\xd7\x02\xc2\x55\xeb\x34\x35\x85",
+        "\x1b\xdf\xce\x25\x76\xe3\xb7\x07\x83\x1c\x59\x80\x13\xbf\xd8\x88\xb3\x85\x45\x9d\x22\xd2\xba\x95\xee\xee\x31\xbd\xc7\x29\x46\x11",
+    },
+    {
+        &p256_n,
+        "\xb5\x03\x36\xbd\x24\xd9\xd8\xfb\xf7\xd4\x57\xc8\x05\xd3\x39\x52\xa7\x82\xcf\x76\x7f\xcd\xb1\xc2\x14\x01\xe1\x3d\x9c\xef\x5b\xb5",
+        "\xa8\xcc\x3a\x89\x0b\x01\xf9\xa4\x8a\x0a\x4a\xbb\x08\x74\x70\x35\x5e\x87\x18\xe3\xe5\x92\x79\xe1\x67\xfd\xcf\x97\xeb\x66\x17\xca",
+        "\xc8\x3e\x27\xec\xb2\xb7\xe9\x9f\xa7\x27\x5f\x62\xd4\xf3\xc8\x24\xe6\x94\x30\x87\xbc\x11\x08\xe2\x1c\x48\xf8\xb8\xa5\x1b\x46\x0d",
+    },
+    {
+        &p256_n,
+        "\x51\xea\x0e\xdc\x3a\x51\xd3\x02\x12\x26\x02\x88\xd1\x26\x26\x10\xd4\x79\x9c\xab\xa7\xc8\x80\xdd\xae\x40\x25\x21\xc8\x67\x13\xc7",
+        "\xa0\x26\x14\x03\x64\xf1\xc8\xad\x02\x56\xed\xf7\x3e\x3d\xf8\x58\x1f\x1b\x98\xcf\x8a\xaf\xa6\x82\x17\xd7\x3a\x17\xb5\x23\xaa\x1d",
+        "\x77\x17\xc5\x59\x19\xd3\xe4\x46\x82\x5c\x6d\x79\xdf\xb3\xc4\xfd\x31\x55\x06\x24\x0e\x75\x21\xe9\x25\x52\x6e\xb5\xad\x48\xe6\x3e",
+    },
+};
+
+static const char rfc6979_priv[] =
+    "\xc9\xaf\xa9\xd8\x45\xba\x75\x16\x6b\x5c\x21\x57\x67\xb1\xd6\x93\x4e\x50\xc3\xdb\x36\xe8\x9b\x12\x7b\x8a\x62\x2b\x12\x0f\x67\x21";
+
+static const struct
+{
+    const char * hash;
+    const char * sig;
+} rfc6979_vectors[] = {
+    {
+        // SHA-256("sample")
+        "\xaf\x2b\xdb\xe1\xaa\x9b\x6e\xc1\xe2\xad\xe1\xd6\x94\xf4\x1f\xc7\x1a\x83\x1d\x02\x68\xe9\x89\x15\x62\x11\x3d\x8a\x62\xad\xd1\xbf",
+        "\xef\xd4\x8b\x2a\xac\xb6\xa8\xfd\x11\x40\xdd\x9c\xd4\x5e\x81\xd6\x9d\x2c\x87\x7b\x56\xaa\xf9\x91\xc3\x4d\x0e\xa8\x4e\xaf\x37\x16\xf7\xcb\x1c\x94\x2d\x65\x7c\x41\xd4\x36\xc7\xa1\xb6\xe2\x9f\x65\xf3\xe9\x00\xdb\xb9\xaf\xf4\x06\x4d\xc4\xab\x2f\x84\x3a\xcd\xa8",
+    },
+    {
+        // SHA-256("test")
+        "\x9f\x86\xd0\x81\x88\x4c\x7d\x65\x9a\x2f\xea\xa0\xc5\x5a\xd0\x15\xa3\xbf\x4f\x1b\x2b\x0b\x82\x2c\xd1\x5d\x6c\x15\xb0\xf0\x0a\x08",
+        "\xf1\xab\xb0\x23\x51\x83\x51\xcd\x71\xd8\x81\x56\x7b\x1e\xa6\x63\xed\x3e\xfc\xf6\xc5\x13\x2b\x35\x4f\x28\xd3\xb0\xb7\xd3\x83\x67\x01\x9f\x41\x13\x74\x2a\x2b\x14\xbd\x25\x92\x6b\x49\xc6\x49\x15\x5f\x26\x7e\x60\xd3\x81\x4b\x4c\x0c\xc8\x42\x50\xe4\x6f\x00\x83",
+    },
+};
+
+static void test_vectors()
+{
+    uint8_t pub[64], sig[64];
+    unsigned int i;
+
+    for (i = 0; i < sizeof(vectors)/sizeof(vectors[0]); i++)
+    {
+        check(p256_base_mult((const uint8_t *)vectors[i].priv, pub));
+        check(memcmp(pub, vectors[i].pub, 64) == 0);
+        check(p256_sign((const uint8_t *)vectors[i].priv, (const uint8_t *)vectors[i].hash, 32,
+                        (const uint8_t *)vectors[i].k, sig));
+        check(memcmp(sig, vectors[i].sig, 64) == 0);
+    }
+}
+
+static void test_products()
+{
+    p256_int a, b, r;
+    uint8_t out[32];
+    unsigned int i;
+
+    for (i = 0; i < sizeof(products)/sizeof(products[0]); i++)
+    {
+        p256_int_from_bytes(&a, (const uint8_t *)products[i].a);
+        p256_int_from_bytes(&b, (const uint8_t *)products[i].b);
+        p256_mod_mul(&r, &a, &b, products[i].m);
+        p256_int_to_bytes(out, &r);
+        check(memcmp(out, products[i].r, 32) == 0);
+    }
+}
+
+// Scalars outside [1, n - 1] are refused
+static void test_range()
+{
+    uint8_t zero[32], n[32], pub[64], sig[64];
+
+    memset(zero, 0, sizeof(zero));
+    memmove(n, order, 32);
+
+    check(!p256_base_mult(zero, pub));
+    check(!p256_base_mult(n, pub));
+    check(!p256_sign((const uint8_t *)vectors[2].priv, zero, 32, zero, sig));
+    check(!p256_sign((const uint8_t *)vectors[2].priv, zero, 32, n, sig));
+
+    n[31]--;
+    check(p256_base_mult(n, pub));
+    check(memcmp(pub, vectors[1].pub, 64) == 0);
+}
+
+static void test_deterministic()
+{
+    uint8_t zero[32], sig[64];
+    unsigned int i;
+
+    for (i = 0; i < sizeof(rfc6979_vectors)/sizeof(rfc6979_vectors[0]); i++)
+    {
+        check(p256_sign_deterministic((const uint8_t *)rfc6979_priv,
+                                      (const uint8_t *)rfc6979_vectors[i].hash, 32, sig));
+        check(memcmp(sig, rfc6979_vectors[i].sig, 64) == 0);
+    }
+
+    memset(zero, 0, sizeof(zero));
+    check(!p256_sign_deterministic(zero, (const uint8_t *)rfc6979_vectors[0].hash, 32, sig));
+    check(!p256_sign_deterministic(order, (const uint8_t *)rfc6979_vectors[0].hash, 32, sig));
+}
+
+// Short hashes are left padded, long ones truncated
+static void test_hash_length()
+{
+    uint8_t hash[40], sig1[64], sig2[64];
+    const uint8_t * priv = (const uint8_t *)vectors[3].priv;
+    const uint8_t * k = (const uint8_t *)vectors[3].k;
+
+    memset(hash, 0, sizeof(hash));
+    memmove(hash + 12, vectors[3].hash, 20);
+    check(p256_sign(priv, hash, 32, k, sig1));
+    check(p256_sign(priv, hash + 12, 20, k, sig2));
+    check(memcmp(sig1, sig2, 64) == 0);
+
+    memmove(hash, vectors[3].hash, 32);
+    check(p256_sign(priv, hash, 40, k, sig1));
+    check(memcmp(sig1, vectors[3].sig, 64) == 0);
+}
+
+int main(int argc, char * argv[])
+{
+    test_products();
+    test_vectors();
+    test_range();
+    test_hash_length();
+    test_deterministic();
+    printf("p256: all tests passed with %d comb teeth, %d-bit limbs\n", P256_COMB_TEETH, P256_LIMB_BITS);
+    return 0;
+}
@@ -17,6 +17,21 @@
 #include <memory.h>
 #include "sha256.h"
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SHA256_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) && defined(__aarch64__) && (defined(__linux__) || defined(__APPLE__))
+#define SHA256_ARMV8
+#include <arm_neon.h>
+#ifdef __linux__
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#endif
+
 /****************************** MACROS ******************************/
 #define ROTLEFT(a,b) (((a) << (b)) | ((a) >> (32-(b))))
 #define ROTRIGHT(a,b) (((a) >> (b)) | ((a) << (32-(b))))
@@ -40,24 +55,24 @@ static const WORD k[64] = {
 	0x748f82ee,0x78a5636f,0x84c87814,0x8cc70208,0x90befffa,0xa4506ceb,0xbef9a3f7,0xc67178f2
 };
 
-/*********************** FUNCTION DEFINITIONS ***********************/
-void sha256_transform(SHA256_CTX *ctx, const BYTE data[])
+/*********************** COMPRESSION BACKENDS ***********************/
+static void sha256_compress_portable(WORD state[8], const BYTE data[])
 {
 	WORD a, b, c, d, e, f, g, h, i, j, t1, t2, m[64];
 
 	for (i = 0, j = 0; i < 16; ++i, j += 4)
-		m[i] = (data[j] << 24) | (data[j + 1] << 16) | (data[j + 2] << 8) | (data[j + 3]);
+		m[i] = ((WORD)data[j] << 24) | (data[j + 1] << 16) | (data[j + 2] << 8) | (data[j + 3]);
 	for ( ; i < 64; ++i)
 		m[i] = SIG1(m[i - 2]) + m[i - 7] + SIG0(m[i - 15]) + m[i - 16];
 
-	a = ctx->state[0];
-	b = ctx->state[1];
-	c = ctx->state[2];
-	d = ctx->state[3];
-	e = ctx->state[4];
-	f = ctx->state[5];
-	g = ctx->state[6];
-	h = ctx->state[7];
+	a = state[0];
+	b = state[1];
+	c = state[2];
+	d = state[3];
+	e = state[4];
+	f = state[5];
+	g = state[6];
+	h = state[7];
 
 	for (i = 0; i < 64; ++i) {
 		t1 = h + EP1(e) + CH(e,f,g) + k[i] + m[i];
@@ -72,14 +87,238 @@ void sha256_transform(SHA256_CTX *ctx, const BYTE data[])
 		a = t1 + t2;
 	}
 
-	ctx->state[0] += a;
-	ctx->state[1] += b;
-	ctx->state[2] += c;
-	ctx->state[3] += d;
-	ctx->state[4] += e;
-	ctx->state[5] += f;
-	ctx->state[6] += g;
-	ctx->state[7] += h;
+	state[0] += a;
+	state[1] += b;
+	state[2] += c;
+	state[3] += d;
+	state[4] += e;
+	state[5] += f;
+	state[6] += g;
+	state[7] += h;
+}
+
+#ifdef SHA256_X86
+
+typedef WORD v4w __attribute__((vector_size(16)));
+typedef WORD v8w __attribute__((vector_size(32)));
+
+#define VROTRIGHT(a,b) (((a) >> (b)) | ((a) << (32-(b))))
+#define VEP0(x) (VROTRIGHT(x,2) ^ VROTRIGHT(x,13) ^ VROTRIGHT(x,22))
+#define VEP1(x) (VROTRIGHT(x,6) ^ VROTRIGHT(x,11) ^ VROTRIGHT(x,25))
+#define VSIG0(x) (VROTRIGHT(x,7) ^ VROTRIGHT(x,18) ^ ((x) >> 3))
+#define VSIG1(x) (VROTRIGHT(x,17) ^ VROTRIGHT(x,19) ^ ((x) >> 10))
+
+// Same rounds as sha256_compress_portable() with word j of each vector belonging
+// to lane j.  The message words are transposed on the way in.
+#define SHA256_TRANSFORM_LANES(vec, n, state, data) do { \
+	vec a, b, c, d, e, f, g, h, t1, t2, m[64], s[8]; \
+	int i, j, l; \
+	for (i = 0; i < 16; ++i) \
+		for (l = 0, j = i * 4; l < n; ++l) \
+			m[i][l] = ((WORD)data[l][j] << 24) | (data[l][j + 1] << 16) | (data[l][j + 2] << 8) | (data[l][j + 3]); \
+	for ( ; i < 64; ++i) \
+		m[i] = VSIG1(m[i - 2]) + m[i - 7] + VSIG0(m[i - 15]) + m[i - 16]; \
+	for (i = 0; i < 8; ++i) \
+		for (l = 0; l < n; ++l) \
+			s[i][l] = state[l][i]; \
+	a = s[0]; b = s[1]; c = s[2]; d = s[3]; \
+	e = s[4]; f = s[5]; g = s[6]; h = s[7]; \
+	for (i = 0; i < 64; ++i) { \
+		t1 = h + VEP1(e) + ((e & f) ^ (~e & g)) + k[i] + m[i]; \
+		t2 = VEP0(a) + ((a & b) ^ (a & c) ^ (b & c)); \
+		h = g; g = f; f = e; e = d + t1; \
+		d = c; c = b; b = a; a = t1 + t2; \
+	} \
+	s[0] += a; s[1] += b; s[2] += c; s[3] += d; \
+	s[4] += e; s[5] += f; s[6] += g; s[7] += h; \
+	for (i = 0; i < 8; ++i) \
+		for (l = 0; l < n; ++l) \
+			state[l][i] = s[i][l]; \
+} while (0)
+
+__attribute__((target("sse4.1")))
+static void sha256_transform_x4(WORD state[][8], const BYTE data[][64])
+{
+	SHA256_TRANSFORM_LANES(v4w, 4, state, data);
+}
+
+__attribute__((target("avx2")))
+static void sha256_transform_x8(WORD state[][8], const BYTE data[][64])
+{
+	SHA256_TRANSFORM_LANES(v8w, 8, state, data);
+}
+
+__attribute__((target("sha,sse4.1")))
+static void sha256_compress_shani(WORD state[8], const BYTE data[])
+{
+	const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+	__m128i state0, state1, abef, cdgh, msg, tmp, m[4];
+	int i;
+
+	// Rearrange the state into the ABEF/CDGH order the instructions use
+	tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[0]), 0xb1);
+	state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[4]), 0x1b);
+	state0 = _mm_alignr_epi8(tmp, state1, 8);
+	state1 = _mm_blend_epi16(state1, tmp, 0xf0);
+	abef = state0;
+	cdgh = state1;
+
+	for (i = 0; i < 4; ++i)
+		m[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + i * 16)), mask);
+
+	// Four rounds per step, scheduling the message words of step i + 4
+	for (i = 0; i < 16; ++i) {
+		msg = _mm_add_epi32(m[i & 3], _mm_loadu_si128((const __m128i *)&k[i * 4]));
+		state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+		state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0e));
+		if (i < 12) {
+			tmp = _mm_alignr_epi8(m[(i + 3) & 3], m[(i + 2) & 3], 4);
+			m[i & 3] = _mm_add_epi32(_mm_sha256msg1_epu32(m[i & 3], m[(i + 1) & 3]), tmp);
+			m[i & 3] = _mm_sha256msg2_epu32(m[i & 3], m[(i + 3) & 3]);
+		}
+	}
+
+	state0 = _mm_add_epi32(state0, abef);
+	state1 = _mm_add_epi32(state1, cdgh);
+
+	tmp = _mm_shuffle_epi32(state0, 0x1b);
+	state1 = _mm_shuffle_epi32(state1, 0xb1);
+	state0 = _mm_blend_epi16(tmp, state1, 0xf0);
+	state1 = _mm_alignr_epi8(state1, tmp, 8);
+	_mm_storeu_si128((__m128i *)&state[0], state0);
+	_mm_storeu_si128((__m128i *)&state[4], state1);
+}
+
+#endif   // SHA256_X86
+
+#ifdef SHA256_ARMV8
+
+__attribute__((target("arch=armv8-a+crypto")))
+static void sha256_compress_armv8(WORD state[8], const BYTE data[])
+{
+	uint32x4_t state0, state1, abcd, efgh, msg[4], tmp0, tmp1;
+	int i;
+
+	state0 = vld1q_u32(&state[0]);
+	state1 = vld1q_u32(&state[4]);
+	abcd = state0;
+	efgh = state1;
+
+	for (i = 0; i < 4; ++i)
+		msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + i * 16)));
+
+	// Four rounds per step, scheduling the message words of step i + 4
+	for (i = 0; i < 16; ++i) {
+		tmp0 = vaddq_u32(msg[i & 3], vld1q_u32(&k[i * 4]));
+		if (i < 12)
+			msg[i & 3] = vsha256su1q_u32(vsha256su0q_u32(msg[i & 3], msg[(i + 1) & 3]),
+					msg[(i + 2) & 3], msg[(i + 3) & 3]);
+		tmp1 = state0;
+		state0 = vsha256hq_u32(state0, state1, tmp0);
+		state1 = vsha256h2q_u32(state1, tmp1, tmp0);
+	}
+
+	vst1q_u32(&state[0], vaddq_u32(state0, abcd));
+	vst1q_u32(&state[4], vaddq_u32(state1, efgh));
+}
+
+#endif   // SHA256_ARMV8
+
+static const struct {
+	const char *name;
+	void (*compress)(WORD state[8], const BYTE data[]);
+} backends[SHA256_BACKEND_COUNT] = {
+	[SHA256_BACKEND_PORTABLE] = { "portable", sha256_compress_portable },
+#ifdef SHA256_X86
+	[SHA256_BACKEND_SHANI] = { "sha-ni", sha256_compress_shani },
+#endif
+#ifdef SHA256_ARMV8
+	[SHA256_BACKEND_ARMV8] = { "armv8", sha256_compress_armv8 },
+#endif
+};
+
+// Portable until sha256_select_auto() runs at load time, before main() and
+// any thread that could hash.
+static void (*sha256_compress)(WORD state[8], const BYTE data[]) = sha256_compress_portable;
+static int sha256_backend = SHA256_BACKEND_PORTABLE;
+static int sha256_lanes = 1;
+
+static int sha256_cpu_has(int backend)
+{
+#ifdef SHA256_X86
+	unsigned int eax, ebx, ecx, edx;
+#endif
+
+	if (backend <= SHA256_BACKEND_AUTO || backend >= SHA256_BACKEND_COUNT ||
+			backends[backend].compress == NULL)
+		return 0;
+
+	switch (backend) {
+#ifdef SHA256_X86
+	case SHA256_BACKEND_SHANI:
+		__builtin_cpu_init();
+		return __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & (1 << 29)) &&
+				__builtin_cpu_supports("sse4.1");
+#endif
+#ifdef SHA256_ARMV8
+	case SHA256_BACKEND_ARMV8:
+#ifdef __linux__
+		return (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+#else
+		return 1;
+#endif
+#endif
+	default:
+		return 1;
+	}
+}
+
+int sha256_select_backend(int backend)
+{
+	int lanes = 1;
+
+	if (backend == SHA256_BACKEND_AUTO) {
+		for (backend = SHA256_BACKEND_COUNT - 1; !sha256_cpu_has(backend); --backend)
+			;
+	}
+	else if (!sha256_cpu_has(backend)) {
+		return 0;
+	}
+
+	// Without single stream instructions, lanes still go side by side
+#ifdef SHA256_X86
+	if (backend == SHA256_BACKEND_PORTABLE) {
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2"))
+			lanes = 8;
+		else if (__builtin_cpu_supports("sse4.1"))
+			lanes = 4;
+	}
+#endif
+
+	sha256_lanes = lanes;
+	sha256_backend = backend;
+	sha256_compress = backends[backend].compress;
+	return 1;
+}
+
+#if defined(SHA256_X86) || defined(SHA256_ARMV8)
+__attribute__((constructor))
+static void sha256_select_auto(void)
+{
+	sha256_select_backend(SHA256_BACKEND_AUTO);
+}
+#endif
+
+const char *sha256_backend_name(void)
+{
+	return backends[sha256_backend].name;
+}
+
+/*********************** FUNCTION DEFINITIONS ***********************/
+void sha256_transform(SHA256_CTX *ctx, const BYTE data[])
+{
+	sha256_compress(ctx->state, data);
 }
 
 void sha256_init(SHA256_CTX *ctx)
@@ -98,11 +337,24 @@ void sha256_init(SHA256_CTX *ctx)
 
 void sha256_update(SHA256_CTX *ctx, const BYTE data[], size_t len)
 {
-	WORD i;
+	size_t n;
 
-	for (i = 0; i < len; ++i) {
-		ctx->data[ctx->datalen] = data[i];
-		ctx->datalen++;
+	while (len > 0) {
+		// Whole blocks are compressed straight from the input
+		if (ctx->datalen == 0 && len >= 64) {
+			sha256_transform(ctx, data);
+			ctx->bitlen += 512;
+			data += 64;
+			len -= 64;
+			continue;
+		}
+		n = 64 - ctx->datalen;
+		if (n > len)
+			n = len;
+		memcpy(ctx->data + ctx->datalen, data, n);
+		ctx->datalen += n;
+		data += n;
+		len -= n;
 		if (ctx->datalen == 64) {
 			sha256_transform(ctx, ctx->data);
 			ctx->bitlen += 512;
@@ -156,3 +408,25 @@ void sha256_final(SHA256_CTX *ctx, BYTE hash[])
 		hash[i + 28] = (ctx->state[7] >> (24 - i * 8)) & 0x000000ff;
 	}
 }
+
+/*********************** MULTI-LANE COMPRESSION *********************/
+// Compress one block into each of several independent states.  With the
+// portable backend on x86 the lanes go 8 and 4 at a time through AVX2 and
+// SSE4.1.  Otherwise each lane goes through the selected backend.
+
+void sha256_transform_lanes(WORD state[][8], const BYTE data[][64], int n)
+{
+	int i = 0;
+
+#ifdef SHA256_X86
+	if (sha256_lanes == 8)
+		for ( ; i + 8 <= n; i += 8)
+			sha256_transform_x8(state + i, data + i);
+	if (sha256_lanes >= 4)
+		for ( ; i + 4 <= n; i += 4)
+			sha256_transform_x4(state + i, data + i);
+#endif
+
+	for ( ; i < n; ++i)
+		sha256_compress(state[i], data[i]);
+}
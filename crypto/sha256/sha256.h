@@ -31,4 +31,22 @@ void sha256_init(SHA256_CTX *ctx);
 void sha256_update(SHA256_CTX *ctx, const BYTE data[], size_t len);
 void sha256_final(SHA256_CTX *ctx, BYTE hash[]);
 
+// Compress one 64 byte block into ctx->state
+void sha256_transform(SHA256_CTX *ctx, const BYTE data[]);
+// Compress data[i] into state[i] for each of the n lanes
+void sha256_transform_lanes(WORD state[][8], const BYTE data[][64], int n);
+
+// Compression function backends.  The best one the CPU supports is picked
+// when the program loads.
+#define SHA256_BACKEND_AUTO         0
+#define SHA256_BACKEND_PORTABLE     1
+#define SHA256_BACKEND_SHANI        2   // x86 SHA extensions
+#define SHA256_BACKEND_ARMV8        3   // ARMv8 cryptography extensions
+#define SHA256_BACKEND_COUNT        4
+
+// Returns 0 if the backend isn't built in or the CPU lacks it.  For tests and
+// benchmarks: it must not run while another thread is hashing.
+int sha256_select_backend(int backend);
+const char *sha256_backend_name(void);
+
 #endif   // SHA256_H
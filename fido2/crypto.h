@@ -8,6 +8,18 @@
 #define _CRYPTO_H
 
 #include <stddef.h>
+#include <stdint.h>
+
+#include "sha256.h"
+
+// The PC build has its own AES-256, see crypto/aes256
+#ifdef CRYPTO_AES_HOST
+#include "aes256.h"
+typedef aes256_ctx crypto_aes_ctx;
+#else
+#include "aes.h"
+typedef struct AES_ctx crypto_aes_ctx;
+#endif
 
 #define USE_SOFTWARE_IMPLEMENTATION
 
@@ -19,6 +31,19 @@ void crypto_sha256_final(uint8_t * hash);
 void crypto_sha256_hmac_init(uint8_t * key, uint32_t klen, uint8_t * hmac);
 void crypto_sha256_hmac_final(uint8_t * key, uint32_t klen, uint8_t * hmac);
 
+// Same as above, but the state lives in a context owned by the caller,
+// so hashes can be interleaved and run from more than one thread.
+void crypto_sha256_ctx_init(SHA256_CTX * ctx);
+void crypto_sha256_ctx_update(SHA256_CTX * ctx, const uint8_t * data, size_t len);
+void crypto_sha256_ctx_final(SHA256_CTX * ctx, uint8_t * hash);
+
+void crypto_hmac_ctx_init(SHA256_CTX * ctx, uint8_t * key, uint32_t klen);
+void crypto_hmac_ctx_final(SHA256_CTX * ctx, uint8_t * key, uint32_t klen, uint8_t * hmac);
+
+// HMAC each of @n messages of @len bytes, stored back to back in @msgs.
+// Short messages under the master or transport key are hashed side by side.
+void crypto_hmac_batch(uint8_t * key, uint32_t klen, uint8_t * msgs, uint32_t len, int n, uint8_t (*hmacs)[32]);
+
 void crypto_sha512_init();
 void crypto_sha512_update(const uint8_t * data, size_t len);
 void crypto_sha512_final(uint8_t * hash);
@@ -33,6 +58,10 @@ void crypto_load_external_key(uint8_t * key, int len);
 void crypto_ecc256_sign(uint8_t * data, int len, uint8_t * sig);
 void crypto_ecdsa_sign(uint8_t * data, int len, uint8_t * sig, int MBEDTLS_ECP_ID);
 
+// Sign with @key instead of the key loaded above
+void crypto_ecc256_sign_with_key(const uint8_t * key, uint8_t * data, int len, uint8_t * sig);
+void crypto_ecdsa_sign_with_key(const uint8_t * key, int key_len, uint8_t * data, int len, uint8_t * sig, int MBEDTLS_ECP_ID);
+
 
 void generate_private_key(uint8_t * data, int len, uint8_t * data2, int len2, uint8_t * privkey);
 void crypto_ecc256_make_key_pair(uint8_t * pubkey, uint8_t * privkey);
@@ -48,6 +77,11 @@ void crypto_aes256_reset_iv(uint8_t * nonce);
 void crypto_aes256_decrypt(uint8_t * buf, int lenth);
 void crypto_aes256_encrypt(uint8_t * buf, int lenth);
 
+void crypto_aes_ctx_init(crypto_aes_ctx * ctx, uint8_t * key, uint8_t * nonce);
+void crypto_aes_ctx_reset_iv(crypto_aes_ctx * ctx, uint8_t * nonce);
+void crypto_aes_ctx_decrypt(crypto_aes_ctx * ctx, uint8_t * buf, int length);
+void crypto_aes_ctx_encrypt(crypto_aes_ctx * ctx, uint8_t * buf, int length);
+
 void crypto_reset_master_secret();
 void crypto_load_master_secret(uint8_t * key);
 
@@ -23,29 +23,64 @@
 #include "wallet.h"
 #include "extensions.h"
 
+// Number of getNextAssertion responses to sign ahead while idle
+#ifndef NEXT_ASSERTION_PRECOMPUTE
+#define NEXT_ASSERTION_PRECOMPUTE   0
+#endif
+
 #include "device.h"
 
-uint8_t PIN_TOKEN[PIN_TOKEN_SIZE];
-uint8_t KEY_AGREEMENT_PUB[64];
-static uint8_t KEY_AGREEMENT_PRIV[32];
-static uint8_t PIN_CODE_HASH[32];
-static int8_t PIN_BOOT_ATTEMPTS_LEFT = PIN_BOOT_ATTEMPTS;
+AUTHENTICATOR_LOCAL uint8_t PIN_TOKEN[PIN_TOKEN_SIZE];
+AUTHENTICATOR_LOCAL uint8_t KEY_AGREEMENT_PUB[64];
+static AUTHENTICATOR_LOCAL uint8_t KEY_AGREEMENT_PRIV[32];
+static AUTHENTICATOR_LOCAL uint8_t PIN_CODE_HASH[32];
+static AUTHENTICATOR_LOCAL int8_t PIN_BOOT_ATTEMPTS_LEFT = PIN_BOOT_ATTEMPTS;
 
-AuthenticatorState STATE;
+AUTHENTICATOR_LOCAL AuthenticatorState STATE;
 
 static void ctap_reset_key_agreement();
 
-static struct {
+// SHA-256 of the ECDH secret with the last platform key seen, so repeated
+// clientPIN and hmac-secret requests from one platform skip the scalar
+// multiplication.  Cleared whenever KEY_AGREEMENT_PRIV changes.
+static AUTHENTICATOR_LOCAL struct {
+    uint8_t valid;
+    uint8_t platform_pubkey[64];
+    uint8_t shared_secret[32];
+} SHARED_SECRET_CACHE;
+
+static AUTHENTICATOR_LOCAL struct {
     CTAP_authDataHeader authData;
     uint8_t clientDataHash[CLIENT_DATA_HASH_SIZE];
-    CTAP_credentialDescriptor creds[ALLOW_LIST_MAX_SIZE-1];
+    CTAP_credentialDescriptor creds[ALLOW_LIST_MAX_SIZE];
     uint8_t lastcmd;
     uint32_t count;
     uint32_t index;
-    uint32_t time;
+    uint32_t time;          // of the last getAssertion or getNextAssertion
     uint8_t user_verified;
+    uint32_t precomputed;   // credentials on top of creds signed in advance
+    uint32_t cid;           // CTAPHID channel of the getAssertion
 } getAssertionState;
 
+#if NEXT_ASSERTION_PRECOMPUTE > 0
+// getNextAssertion signatures made by ctap_idle(), for creds[i] in slot
+// i % NEXT_ASSERTION_PRECOMPUTE.  Each took its signCount when it was made,
+// and they are made in the order they are returned, so the counts still
+// only go up.  A dropped one just leaves a gap.
+static AUTHENTICATOR_LOCAL struct {
+    CTAP_authDataHeader authData;
+    uint8_t sigder[72];
+    int sigder_sz;
+} nextAssertionSigs[NEXT_ASSERTION_PRECOMPUTE];
+#endif
+
+// Compact copy of each resident key's rpIdHash and user id so lookups only
+// load the keys that can match.
+static AUTHENTICATOR_LOCAL struct {
+    uint32_t rp;            // first 4 bytes of rpIdHash
+    uint32_t user;          // hash of the user id
+} rkIndex[RK_INDEX_SIZE];
+
 uint8_t verify_pin_auth(uint8_t * pinAuth, uint8_t * clientDataHash)
 {
     uint8_t hmac[32];
@@ -70,7 +105,15 @@ uint8_t verify_pin_auth(uint8_t * pinAuth, uint8_t * clientDataHash)
 
 
 
-uint8_t ctap_get_info(CborEncoder * encoder)
+// The getInfo response only changes with the clientPin option, so it is
+// encoded once and that one byte is patched when the PIN is set or reset.
+static AUTHENTICATOR_LOCAL struct {
+    uint8_t buf[128];
+    uint16_t size;
+    uint16_t clientPin;     // offset of the clientPin boolean in buf
+} getInfoCache;
+
+static uint8_t ctap_encode_info(CborEncoder * encoder, uint8_t * buf)
 {
     int ret;
     CborEncoder array;
@@ -157,6 +200,7 @@ uint8_t ctap_get_info(CborEncoder * encoder)
 
                 ret = cbor_encode_text_string(&options, "clientPin", 9);
                 check_ret(ret);
+                getInfoCache.clientPin = cbor_encoder_get_buffer_size(&options, buf);
                 {
                     ret = cbor_encode_boolean(&options, ctap_is_pin_set());
                     check_ret(ret);
@@ -200,6 +244,48 @@ uint8_t ctap_get_info(CborEncoder * encoder)
     return CTAP1_ERR_SUCCESS;
 }
 
+static uint8_t ctap_cache_info()
+{
+    CborEncoder encoder;
+    int ret;
+
+    getInfoCache.size = 0;
+    cbor_encoder_init(&encoder, getInfoCache.buf, sizeof(getInfoCache.buf), 0);
+    ret = ctap_encode_info(&encoder, getInfoCache.buf);
+    check_retr(ret);
+    getInfoCache.size = cbor_encoder_get_buffer_size(&encoder, getInfoCache.buf);
+    return 0;
+}
+
+// Patch the clientPin option in the cached getInfo response
+static void ctap_cache_info_pin()
+{
+    if (getInfoCache.size)
+    {
+        // CBOR simple values false and true
+        getInfoCache.buf[getInfoCache.clientPin] = ctap_is_pin_set() ? 0xf5 : 0xf4;
+    }
+}
+
+// Copy the getInfo response to @buf
+uint8_t ctap_get_info(uint8_t * buf, uint16_t buf_size, uint16_t * length)
+{
+    int ret;
+
+    if (!getInfoCache.size)
+    {
+        ret = ctap_cache_info();
+        check_retr(ret);
+    }
+    if (getInfoCache.size > buf_size)
+    {
+        return CTAP1_ERR_OTHER;
+    }
+    memmove(buf, getInfoCache.buf, getInfoCache.size);
+    *length = getInfoCache.size;
+    return CTAP1_ERR_SUCCESS;
+}
+
 
 
 static int ctap_add_cose_key(CborEncoder * cose_key, uint8_t * x, uint8_t * y, uint8_t credtype, int32_t algtype)
@@ -275,14 +361,15 @@ static int ctap_generate_cose_key(CborEncoder * cose_key, uint8_t * hmac_input,
     return 0;
 }
 
-void make_auth_tag(uint8_t * rpIdHash, uint8_t * nonce, uint32_t count, uint8_t * tag)
+void make_auth_tag(const uint8_t * rpIdHash, const uint8_t * nonce, uint32_t count, uint8_t * tag)
 {
     uint8_t hashbuf[32];
-    crypto_sha256_hmac_init(CRYPTO_TRANSPORT_KEY, 0, hashbuf);
-    crypto_sha256_update(rpIdHash, 32);
-    crypto_sha256_update(nonce, CREDENTIAL_NONCE_SIZE);
-    crypto_sha256_update((uint8_t*)&count, 4);
-    crypto_sha256_hmac_final(CRYPTO_TRANSPORT_KEY,0,hashbuf);
+    SHA256_CTX ctx;
+    crypto_hmac_ctx_init(&ctx, CRYPTO_TRANSPORT_KEY, 0);
+    crypto_sha256_ctx_update(&ctx, rpIdHash, 32);
+    crypto_sha256_ctx_update(&ctx, nonce, CREDENTIAL_NONCE_SIZE);
+    crypto_sha256_ctx_update(&ctx, (uint8_t*)&count, 4);
+    crypto_hmac_ctx_final(&ctx, CRYPTO_TRANSPORT_KEY, 0, hashbuf);
 
     memmove(tag, hashbuf, CREDENTIAL_TAG_SIZE);
 }
@@ -327,6 +414,79 @@ static int is_matching_rk(CTAP_residentKey * rk, CTAP_residentKey * rk2)
            (rk->user.id_size == rk2->user.id_size);
 }
 
+static uint32_t rk_index_rp(uint8_t * rpIdHash)
+{
+    return ((uint32_t)rpIdHash[0] << 24) | ((uint32_t)rpIdHash[1] << 16) |
+           ((uint32_t)rpIdHash[2] << 8) | rpIdHash[3];
+}
+
+// FNV-1a of the user id
+static uint32_t rk_index_user(CTAP_userEntity * user)
+{
+    uint32_t h = 2166136261UL;
+    int i;
+    for (i = 0; i < user->id_size && i < USER_ID_MAX_SIZE; i++)
+    {
+        h = (h ^ user->id[i]) * 16777619UL;
+    }
+    return h ^ user->id_size;
+}
+
+static void rk_index_set(unsigned int index, CTAP_residentKey * rk)
+{
+    if (index < RK_INDEX_SIZE)
+    {
+        rkIndex[index].rp = rk_index_rp(rk->id.rpIdHash);
+        rkIndex[index].user = rk_index_user(&rk->user);
+    }
+}
+
+// Load every stored resident key once to rebuild the index
+static void rk_index_build()
+{
+    CTAP_residentKey rk;
+    unsigned int i;
+    for (i = 0; i < STATE.rk_stored && i < RK_INDEX_SIZE; i++)
+    {
+        ctap_load_rk(i, &rk);
+        rk_index_set(i, &rk);
+    }
+}
+
+// @return 1 if the resident key at index may be for rpIdHash (and user,
+// if it isn't NULL), 0 if it certainly isn't.
+static int rk_index_may_match(unsigned int index, uint8_t * rpIdHash, CTAP_userEntity * user)
+{
+    if (index >= RK_INDEX_SIZE)
+    {
+        return 1;
+    }
+    if (rkIndex[index].rp != rk_index_rp(rpIdHash))
+    {
+        return 0;
+    }
+    return user == NULL || rkIndex[index].user == rk_index_user(user);
+}
+
+// shared_secret = SHA-256 of the ECDH secret of KEY_AGREEMENT_PRIV and @platform_pubkey
+static void ctap_platform_shared_secret(const uint8_t * platform_pubkey, uint8_t * shared_secret)
+{
+    if (SHARED_SECRET_CACHE.valid && memcmp(SHARED_SECRET_CACHE.platform_pubkey, platform_pubkey, 64) == 0)
+    {
+        memmove(shared_secret, SHARED_SECRET_CACHE.shared_secret, 32);
+        return;
+    }
+
+    crypto_ecc256_shared_secret(platform_pubkey, KEY_AGREEMENT_PRIV, shared_secret);
+    crypto_sha256_init();
+    crypto_sha256_update(shared_secret, 32);
+    crypto_sha256_final(shared_secret);
+
+    memmove(SHARED_SECRET_CACHE.platform_pubkey, platform_pubkey, 64);
+    memmove(SHARED_SECRET_CACHE.shared_secret, shared_secret, 32);
+    SHARED_SECRET_CACHE.valid = 1;
+}
+
 static int ctap_make_extensions(CTAP_extensions * ext, uint8_t * ext_encoder_buf, unsigned int * ext_encoder_buf_size)
 {
     CborEncoder extensions;
@@ -340,12 +500,7 @@ static int ctap_make_extensions(CTAP_extensions * ext, uint8_t * ext_encoder_buf
     {
         printf1(TAG_CTAP, "Processing hmac-secret..\r\n");
 
-        crypto_ecc256_shared_secret((uint8_t*) &ext->hmac_secret.keyAgreement.pubkey,
-                                    KEY_AGREEMENT_PRIV,
-                                    shared_secret);
-        crypto_sha256_init();
-        crypto_sha256_update(shared_secret, 32);
-        crypto_sha256_final(shared_secret);
+        ctap_platform_shared_secret((uint8_t*) &ext->hmac_secret.keyAgreement.pubkey, shared_secret);
 
         crypto_sha256_hmac_init(shared_secret, 32, hmac);
         crypto_sha256_update(ext->hmac_secret.saltEnc, ext->hmac_secret.saltLen);
@@ -363,7 +518,7 @@ static int ctap_make_extensions(CTAP_extensions * ext, uint8_t * ext_encoder_buf
 
         // Generate credRandom
         crypto_sha256_hmac_init(CRYPTO_TRANSPORT_KEY, 0, credRandom);
-        crypto_sha256_update((uint8_t*)&ext->hmac_secret.credential->id, sizeof(CredentialId));
+        crypto_sha256_update((uint8_t*)ext->hmac_secret.credential, sizeof(CredentialId));
         crypto_sha256_hmac_final(CRYPTO_TRANSPORT_KEY, 0, credRandom);
 
         // Decrypt saltEnc
@@ -432,6 +587,32 @@ static int ctap_make_extensions(CTAP_extensions * ext, uint8_t * ext_encoder_buf
 }
 
 
+// Like cbor_value_copy_text_string(), a string too long for @dst is left
+// out rather than cut.  The last byte of @dst is always NULL.
+static void copy_text_view(uint8_t * dst, size_t len, const CTAP_view * view)
+{
+    memset(dst, 0, len);
+    if (view->ptr != NULL && view->size <= len)
+    {
+        memmove(dst, view->ptr, view->size);
+    }
+    dst[len - 1] = 0;
+}
+
+// Copy the user entity of a request out, to be kept as a resident key
+static void copy_user_entity(CTAP_userEntity * user, const CTAP_userView * view)
+{
+    memset(user->id, 0, USER_ID_MAX_SIZE);
+    if (view->id.ptr != NULL)
+    {
+        memmove(user->id, view->id.ptr, view->id.size);
+    }
+    user->id_size = view->id.size;
+    copy_text_view(user->name, USER_NAME_LIMIT, &view->name);
+    copy_text_view(user->displayName, DISPLAY_NAME_LIMIT, &view->displayName);
+    copy_text_view(user->icon, ICON_LIMIT, &view->icon);
+}
+
 static int ctap_make_auth_data(struct rpId * rp, CborEncoder * map, uint8_t * auth_data_buf, uint32_t * len, CTAP_credInfo * credInfo)
 {
     CborEncoder cose_key;
@@ -450,10 +631,10 @@ static int ctap_make_auth_data(struct rpId * rp, CborEncoder * map, uint8_t * au
     }
 
     crypto_sha256_init();
-    crypto_sha256_update(rp->id, rp->size);
+    crypto_sha256_update((uint8_t*)rp->id, rp->size);
     crypto_sha256_final(authData->head.rpIdHash);
 
-    printf1(TAG_RED, "rpId: "); dump_hex1(TAG_RED, rp->id, rp->size);
+    printf1(TAG_RED, "rpId: "); dump_hex1(TAG_RED, (uint8_t*)rp->id, rp->size);
     printf1(TAG_RED, "hash: "); dump_hex1(TAG_RED, authData->head.rpIdHash, 32);
 
     count = auth_data_update_count(&authData->head);
@@ -506,16 +687,21 @@ static int ctap_make_auth_data(struct rpId * rp, CborEncoder * map, uint8_t * au
         if (credInfo->rk)
         {
             memmove(&rk.id, &authData->attest.id, sizeof(CredentialId));
-            memmove(&rk.user, &credInfo->user, sizeof(CTAP_userEntity));
+            copy_user_entity(&rk.user, &credInfo->user);
 
             unsigned int index = STATE.rk_stored;
             unsigned int i;
             for (i = 0; i < index; i++)
             {
+                if (!rk_index_may_match(i, rk.id.rpIdHash, &rk.user))
+                {
+                    continue;
+                }
                 ctap_load_rk(i, &rk2);
                 if (is_matching_rk(&rk, &rk2))
                 {
                     ctap_overwrite_rk(i, &rk);
+                    rk_index_set(i, &rk);
                     goto done_rk;
                 }
             }
@@ -526,6 +712,7 @@ static int ctap_make_auth_data(struct rpId * rp, CborEncoder * map, uint8_t * au
             }
             ctap_increment_rk_store();
             ctap_store_rk(index, &rk);
+            rk_index_set(index, &rk);
             dump_hex1(TAG_GREEN, rk.id.rpIdHash, 32);
         }
 done_rk:
@@ -653,13 +840,47 @@ uint8_t ctap_add_attest_statement(CborEncoder * map, uint8_t * sigder, int len)
 }
 
 // Return 1 if credential belongs to this token
-int ctap_authenticate_credential(struct rpId * rp, CTAP_credentialDescriptor * desc)
+int ctap_authenticate_credential(struct rpId * rp, const CredentialId * id)
 {
     uint8_t tag[16];
 
-    make_auth_tag(desc->credential.id.rpIdHash, desc->credential.id.nonce, desc->credential.id.count, tag);
+    make_auth_tag(id->rpIdHash, id->nonce, id->count, tag);
+
+    return (memcmp(id->tag, tag, CREDENTIAL_TAG_SIZE) == 0);
+}
+
+// Check the tags of @n credentials at once.  @valid[i] is set to 1 if
+// credential i belongs to this token.
+static void ctap_authenticate_credentials(const CTAP_credentialView * creds, int n, uint8_t * valid)
+{
+    uint8_t msgs[ALLOW_LIST_MAX_SIZE][32 + CREDENTIAL_NONCE_SIZE + 4];
+    uint8_t tags[ALLOW_LIST_MAX_SIZE][32];
+    const CredentialId * id;
+    int i, m = 0;
+
+    for (i = 0; i < n; i++)
+    {
+        id = creds[i].id;
+        if (id == NULL)
+        {
+            continue;
+        }
+        memmove(msgs[m], id->rpIdHash, 32);
+        memmove(msgs[m] + 32, id->nonce, CREDENTIAL_NONCE_SIZE);
+        memmove(msgs[m] + 32 + CREDENTIAL_NONCE_SIZE, &id->count, 4);
+        m++;
+    }
+
+    crypto_hmac_batch(CRYPTO_TRANSPORT_KEY, 0, (uint8_t*)msgs, sizeof(msgs[0]), m, tags);
 
-    return (memcmp(desc->credential.id.tag, tag, CREDENTIAL_TAG_SIZE) == 0);
+    for (i = 0, m = 0; i < n; i++)
+    {
+        valid[i] = 0;
+        if (creds[i].id != NULL)
+        {
+            valid[i] = (memcmp(creds[i].id->tag, tags[m++], CREDENTIAL_TAG_SIZE) == 0);
+        }
+    }
 }
 
 
@@ -670,7 +891,7 @@ uint8_t ctap_make_credential(CborEncoder * encoder, uint8_t * request, int lengt
     int ret;
     unsigned int i;
     uint8_t auth_data_buf[310];
-    CTAP_credentialDescriptor * excl_cred = (CTAP_credentialDescriptor *) auth_data_buf;
+    CTAP_credentialView excl_cred;
     uint8_t * sigbuf = auth_data_buf + 32;
     uint8_t * sigder = auth_data_buf + 32 + 64;
 
@@ -709,25 +930,27 @@ uint8_t ctap_make_credential(CborEncoder * encoder, uint8_t * request, int lengt
     // crypto_aes256_init(CRYPTO_TRANSPORT_KEY, NULL);
     for (i = 0; i < MC.excludeListSize; i++)
     {
-        ret = parse_credential_descriptor(&MC.excludeList, excl_cred);
+        ret = parse_credential_descriptor(&MC.excludeList, &excl_cred);
         if (ret == CTAP2_ERR_CBOR_UNEXPECTED_TYPE)
         {
             continue;
         }
         check_retr(ret);
 
-        printf1(TAG_GREEN, "checking credId: "); dump_hex1(TAG_GREEN, (uint8_t*) &excl_cred->credential.id, sizeof(CredentialId));
+        if (excl_cred.id == NULL)
+        {
+            continue;
+        }
+
+        printf1(TAG_GREEN, "checking credId: "); dump_hex1(TAG_GREEN, (uint8_t*) excl_cred.id, sizeof(CredentialId));
         // DELETE
         // crypto_aes256_reset_iv(NULL);
         // crypto_aes256_decrypt((uint8_t*)& excl_cred->credential.enc, CREDENTIAL_ENC_SIZE);
-        if (ctap_authenticate_credential(&MC.rp, excl_cred))
+        if (ctap_authenticate_credential(&MC.rp, excl_cred.id))
         {
             printf1(TAG_MC, "Cred %d failed!\r\n",i);
             return CTAP2_ERR_CREDENTIAL_EXCLUDED;
         }
-
-        ret = cbor_value_advance(&MC.excludeList);
-        check_ret(ret);
     }
 
 
@@ -806,7 +1029,7 @@ static uint8_t ctap_add_credential_descriptor(CborEncoder * map, CTAP_credential
         ret = cbor_encode_text_string(&desc, "id", 2);
         check_ret(ret);
 
-        ret = cbor_encode_byte_string(&desc, (uint8_t*)&cred->credential.id, sizeof(CredentialId));
+        ret = cbor_encode_byte_string(&desc, (uint8_t*)&cred->id, sizeof(CredentialId));
         check_ret(ret);
     }
 
@@ -881,115 +1104,130 @@ static int cred_cmp_func(const void * _a, const void * _b)
 {
     CTAP_credentialDescriptor * a = (CTAP_credentialDescriptor * )_a;
     CTAP_credentialDescriptor * b = (CTAP_credentialDescriptor * )_b;
-    return b->credential.id.count - a->credential.id.count;
+    return b->id.count - a->id.count;
 }
 
-static void add_existing_user_info(CTAP_credentialDescriptor * cred)
+// Load the user of @cred, which has id_size 0 if there is none
+static void load_credential_user(CTAP_credentialDescriptor * cred, CTAP_userEntity * user)
 {
     CTAP_residentKey rk;
-    int index = STATE.rk_stored;
-    int i;
-    for (i = 0; i < index; i++)
+    if (cred->rk < 0)
     {
-        ctap_load_rk(i, &rk);
-        if (is_matching_rk(&rk, (CTAP_residentKey *)&cred->credential))
-        {
-            printf1(TAG_GREEN, "found rk match for allowList item (%d)\r\n", i);
-            memmove(&cred->credential.user, &rk.user, sizeof(CTAP_userEntity));
-            return;
-        }
-
+        memset(user, 0, sizeof(CTAP_userEntity));
+        return;
     }
-    printf1(TAG_GREEN, "NO rk match for allowList item \r\n");
+    ctap_load_rk(cred->rk, &rk);
+    memmove(user, &rk.user, sizeof(CTAP_userEntity));
 }
 
+// Fill @creds with the allowList credentials that belong to this token, or
+// with the resident keys of the rpId if there is no allowList.  @creds has
+// room for ALLOW_LIST_MAX_SIZE.
 // @return the number of valid credentials
-// sorts the credentials.  Most recent creds will be first, invalid ones last.
-int ctap_filter_invalid_credentials(CTAP_getAssertion * GA)
+// sorts the credentials.  Most recent creds will be first.
+int ctap_filter_invalid_credentials(CTAP_getAssertion * GA, CTAP_credentialDescriptor * creds)
 {
     int i;
     int count = 0;
     uint8_t rpIdHash[32];
+    uint8_t valid[ALLOW_LIST_MAX_SIZE];
     CTAP_residentKey rk;
 
+    ctap_authenticate_credentials(GA->allowList, GA->credLen, valid);
+
     for (i = 0; i < GA->credLen; i++)
     {
-        if (! ctap_authenticate_credential(&GA->rp, &GA->creds[i]))
+        if (! valid[i])
         {
-            printf1(TAG_GA, "CRED #%d is invalid\n", GA->creds[i].credential.id.count);
+            printf1(TAG_GA, "allowList item %d is invalid\n", i);
 #ifdef ENABLE_U2F_EXTENSIONS
-            if (is_extension_request((uint8_t*)&GA->creds[i].credential.id, sizeof(CredentialId)))
+            if (GA->allowList[i].id != NULL && is_extension_request((uint8_t*)GA->allowList[i].id, sizeof(CredentialId)))
             {
-                printf1(TAG_EXT, "CRED #%d is extension\n", GA->creds[i].credential.id.count);
-                count++;
+                printf1(TAG_EXT, "CRED #%d is extension\n", GA->allowList[i].id->count);
             }
             else
 #endif
             {
-                GA->creds[i].credential.id.count = 0;      // invalidate
+                continue;
             }
-
-        }
-        else
-        {
-            // add user info if it exists
-            add_existing_user_info(&GA->creds[i]);
-            count++;
         }
+
+        // Only the ones kept are copied out of the request.  A user is only
+        // returned for resident keys found by rpId, so these have none.
+        creds[count].type = GA->allowList[i].type;
+        memmove(&creds[count].id, GA->allowList[i].id, sizeof(CredentialId));
+        creds[count].rk = -1;
+        count++;
     }
 
     // No allowList, so use all matching RK's matching rpId
     if (!GA->credLen)
     {
         crypto_sha256_init();
-        crypto_sha256_update(GA->rp.id,GA->rp.size);
+        crypto_sha256_update((uint8_t*)GA->rp.id,GA->rp.size);
         crypto_sha256_final(rpIdHash);
 
         printf1(TAG_GREEN, "true rpIdHash: ");  dump_hex1(TAG_GREEN, rpIdHash, 32);
         for(i = 0; i < STATE.rk_stored; i++)
         {
+            if (!rk_index_may_match(i, rpIdHash, NULL))
+            {
+                continue;
+            }
             ctap_load_rk(i, &rk);
             printf1(TAG_GREEN, "rpIdHash%d: ", i);  dump_hex1(TAG_GREEN, rk.id.rpIdHash, 32);
             if (memcmp(rk.id.rpIdHash, rpIdHash, 32) == 0)
             {
                 printf1(TAG_GA, "RK %d is a rpId match!\r\n", i);
-                if (count == ALLOW_LIST_MAX_SIZE-1)
+                if (count == ALLOW_LIST_MAX_SIZE)
                 {
                     printf2(TAG_ERR, "not enough ram allocated for matching RK's (%d).  Skipping.\r\n", count);
                     break;
                 }
-                GA->creds[count].type = PUB_KEY_CRED_PUB_KEY;
-                memmove(&(GA->creds[count].credential), &rk, sizeof(CTAP_residentKey));
+                creds[count].type = PUB_KEY_CRED_PUB_KEY;
+                memmove(&creds[count].id, &rk.id, sizeof(CredentialId));
+                creds[count].rk = i;
                 count++;
             }
         }
-        GA->credLen = count;
     }
 
-    printf1(TAG_GA, "qsort length: %d\n", GA->credLen);
-    qsort(GA->creds, GA->credLen, sizeof(CTAP_credentialDescriptor), cred_cmp_func);
+    printf1(TAG_GA, "qsort length: %d\n", count);
+    qsort(creds, count, sizeof(CTAP_credentialDescriptor), cred_cmp_func);
     return count;
 }
 
 
-static void save_credential_list(CTAP_authDataHeader * head, uint8_t * clientDataHash, CTAP_credentialDescriptor * creds, uint32_t count)
+// The credentials are already in getAssertionState.creds, the first @count
+// of them are left for getNextAssertion.
+static void save_credential_list(CTAP_authDataHeader * head, uint8_t * clientDataHash, uint32_t count)
 {
     if(count)
     {
-        if (count > ALLOW_LIST_MAX_SIZE-1)
-        {
-            printf2(TAG_ERR, "ALLOW_LIST_MAX_SIZE Exceeded\n");
-            exit(1);
-        }
         memmove(getAssertionState.clientDataHash, clientDataHash, CLIENT_DATA_HASH_SIZE);
         memmove(&getAssertionState.authData, head, sizeof(CTAP_authDataHeader));
-        memmove(getAssertionState.creds, creds, sizeof(CTAP_credentialDescriptor) * (count));
-
     }
     getAssertionState.count = count;
+    getAssertionState.precomputed = 0;
+    getAssertionState.time = millis();
+    getAssertionState.cid = ctaphid_active_cid();
     printf1(TAG_GA,"saved %d credentials\n",count);
 }
 
+static void ctap_drop_next_assertions()
+{
+    getAssertionState.count = 0;
+    getAssertionState.precomputed = 0;
+}
+
+void ctap_cancel_next_assertions(uint32_t cid)
+{
+    if (cid == getAssertionState.cid)
+    {
+        ctap_drop_next_assertions();
+    }
+}
+
 static CTAP_credentialDescriptor * pop_credential()
 {
     if (getAssertionState.count > 0)
@@ -1003,13 +1241,28 @@ static CTAP_credentialDescriptor * pop_credential()
     }
 }
 
-// adds 2 to map, or 3 if add_user is true
-uint8_t ctap_end_get_assertion(CborEncoder * map, CTAP_credentialDescriptor * cred, uint8_t * auth_data_buf, unsigned int auth_data_buf_sz, uint8_t * clientDataHash)
+// Sign @authData with the key of @cred
+// @return length of the der signature in @sigder (72 bytes)
+static int ctap_sign_assertion(CTAP_credentialDescriptor * cred, CTAP_authDataHeader * authData, uint8_t * clientDataHash, uint8_t * sigder)
 {
-    int ret;
+    uint8_t hashbuf[32];
     uint8_t sigbuf[64];
-    uint8_t sigder[72];
-    int sigder_sz;
+
+    crypto_ecc256_load_key((uint8_t*)&cred->id, sizeof(CredentialId), NULL, 0);
+
+#ifdef ENABLE_U2F_EXTENSIONS
+    if ( extend_fido2(&cred->id, sigder) )
+    {
+        return 72;
+    }
+#endif
+    return ctap_calculate_signature((uint8_t*)authData, sizeof(CTAP_authDataHeader), clientDataHash, hashbuf, sigbuf, sigder);
+}
+
+// adds 3 to map, or 4 if @user has an id
+uint8_t ctap_end_get_assertion(CborEncoder * map, CTAP_credentialDescriptor * cred, CTAP_userEntity * user, uint8_t * auth_data_buf, unsigned int auth_data_buf_sz, uint8_t * sigder, int sigder_sz)
+{
+    int ret;
 
     ret = ctap_add_credential_descriptor(map, cred);  // 1
     check_retr(ret);
@@ -1021,19 +1274,6 @@ uint8_t ctap_end_get_assertion(CborEncoder * map, CTAP_credentialDescriptor * cr
         check_ret(ret);
     }
 
-    crypto_ecc256_load_key((uint8_t*)&cred->credential.id, sizeof(CredentialId), NULL, 0);
-
-#ifdef ENABLE_U2F_EXTENSIONS
-    if ( extend_fido2(&cred->credential.id, sigder) )
-    {
-        sigder_sz = 72;
-    }
-    else
-#endif
-    {
-        sigder_sz = ctap_calculate_signature(auth_data_buf, sizeof(CTAP_authDataHeader), clientDataHash, auth_data_buf, sigbuf, sigder);
-    }
-
     {
         ret = cbor_encode_int(map, RESP_signature);  // 3
         check_ret(ret);
@@ -1041,10 +1281,10 @@ uint8_t ctap_end_get_assertion(CborEncoder * map, CTAP_credentialDescriptor * cr
         check_ret(ret);
     }
 
-    if (cred->credential.user.id_size)
+    if (user->id_size)
     {
         printf1(TAG_GREEN, "adding user details to output\r\n");
-        ret = ctap_add_user_entity(map, &cred->credential.user);  // 4
+        ret = ctap_add_user_entity(map, user);  // 4
         check_retr(ret);
     }
 
@@ -1057,7 +1297,15 @@ uint8_t ctap_get_next_assertion(CborEncoder * encoder)
     int ret;
     CborEncoder map;
     CTAP_authDataHeader authData;
-    memmove(&authData, &getAssertionState.authData, sizeof(CTAP_authDataHeader));
+    CTAP_userEntity user;
+    uint8_t sigder[72];
+    int sigder_sz;
+
+    if (millis() - getAssertionState.time > NEXT_ASSERTION_TIMEOUT)
+    {
+        printf2(TAG_ERR, "getNextAssertion timed out\n");
+        ctap_drop_next_assertions();
+    }
 
     CTAP_credentialDescriptor * cred = pop_credential();
 
@@ -1065,10 +1313,27 @@ uint8_t ctap_get_next_assertion(CborEncoder * encoder)
     {
         return CTAP2_ERR_NOT_ALLOWED;
     }
+    getAssertionState.time = millis();
 
-    auth_data_update_count(&authData);
+#if NEXT_ASSERTION_PRECOMPUTE > 0
+    if (getAssertionState.precomputed)
+    {
+        int slot = getAssertionState.count % NEXT_ASSERTION_PRECOMPUTE;
+        getAssertionState.precomputed--;
+        memmove(&authData, &nextAssertionSigs[slot].authData, sizeof(CTAP_authDataHeader));
+        sigder_sz = nextAssertionSigs[slot].sigder_sz;
+        memmove(sigder, nextAssertionSigs[slot].sigder, sigder_sz);
+    }
+    else
+#endif
+    {
+        memmove(&authData, &getAssertionState.authData, sizeof(CTAP_authDataHeader));
+        auth_data_update_count(&authData);
+        sigder_sz = ctap_sign_assertion(cred, &authData, getAssertionState.clientDataHash, sigder);
+    }
+    load_credential_user(cred, &user);
 
-    if (cred->credential.user.id_size)
+    if (user.id_size)
     {
         printf1(TAG_GREEN, "adding user info to assertion response\r\n");
         ret = cbor_encoder_create_map(encoder, &map, 4);
@@ -1086,10 +1351,10 @@ uint8_t ctap_get_next_assertion(CborEncoder * encoder)
     if (!getAssertionState.user_verified)
     {
         printf1(TAG_GREEN, "Not verified, nulling out user details on response\r\n");
-        memset(cred->credential.user.name, 0, USER_NAME_LIMIT);
+        memset(user.name, 0, USER_NAME_LIMIT);
     }
 
-    ret = ctap_end_get_assertion(&map, cred, (uint8_t *)&authData, sizeof(CTAP_authDataHeader), getAssertionState.clientDataHash);
+    ret = ctap_end_get_assertion(&map, cred, &user, (uint8_t *)&authData, sizeof(CTAP_authDataHeader), sigder, sigder_sz);
     check_retr(ret);
 
     ret = cbor_encoder_close_container(encoder, &map);
@@ -1098,10 +1363,60 @@ uint8_t ctap_get_next_assertion(CborEncoder * encoder)
     return 0;
 }
 
+int ctap_idle_pending()
+{
+#if NEXT_ASSERTION_PRECOMPUTE > 0
+    return getAssertionState.lastcmd == CTAP_GET_ASSERTION &&
+           getAssertionState.precomputed < getAssertionState.count &&
+           getAssertionState.precomputed < NEXT_ASSERTION_PRECOMPUTE;
+#else
+    return 0;
+#endif
+}
+
+void ctap_idle()
+{
+#if NEXT_ASSERTION_PRECOMPUTE > 0
+    uint32_t index;
+    int slot;
+
+    if (!getAssertionState.count)
+    {
+        return;
+    }
+    if (getAssertionState.lastcmd != CTAP_GET_ASSERTION ||
+        millis() - getAssertionState.time > NEXT_ASSERTION_TIMEOUT)
+    {
+        printf1(TAG_GA, "dropping %d credentials\n", getAssertionState.count);
+        ctap_drop_next_assertions();
+        return;
+    }
+    if (!ctap_idle_pending())
+    {
+        return;
+    }
+
+    // The next one to be popped that isn't signed yet
+    index = getAssertionState.count - 1 - getAssertionState.precomputed;
+    slot = index % NEXT_ASSERTION_PRECOMPUTE;
+
+    memmove(&nextAssertionSigs[slot].authData, &getAssertionState.authData, sizeof(CTAP_authDataHeader));
+    auth_data_update_count(&nextAssertionSigs[slot].authData);
+    nextAssertionSigs[slot].sigder_sz = ctap_sign_assertion(&getAssertionState.creds[index],
+            &nextAssertionSigs[slot].authData, getAssertionState.clientDataHash, nextAssertionSigs[slot].sigder);
+
+    getAssertionState.precomputed++;
+    printf1(TAG_GA, "signed credential %d ahead\n", index);
+#endif
+}
+
 uint8_t ctap_get_assertion(CborEncoder * encoder, uint8_t * request, int length)
 {
     CTAP_getAssertion GA;
     uint8_t auth_data_buf[sizeof(CTAP_authDataHeader) + 80];
+    uint8_t sigder[72];
+    int sigder_sz;
+    CTAP_userEntity user;
     int ret = ctap_parse_get_assertion(&GA,request,length);
 
     if (ret != 0)
@@ -1130,14 +1445,27 @@ uint8_t ctap_get_assertion(CborEncoder * encoder, uint8_t * request, int length)
     int map_size = 3;
 
     printf1(TAG_GA, "ALLOW_LIST has %d creds\n", GA.credLen);
-    int validCredCount = ctap_filter_invalid_credentials(&GA);
+
+    // The matches are sorted straight into the getNextAssertion state
+    CTAP_credentialDescriptor * creds = getAssertionState.creds;
+    getAssertionState.count = 0;
+    int validCredCount = ctap_filter_invalid_credentials(&GA, creds);
+
+    if (validCredCount == 0)
+    {
+        printf2(TAG_ERR,"Error, no authentic credential\n");
+        return CTAP2_ERR_NO_CREDENTIALS;
+    }
+
+    CTAP_credentialDescriptor * cred = &creds[validCredCount - 1];
+    load_credential_user(cred, &user);
 
     if (validCredCount > 1)
     {
        map_size += 1;
     }
 
-    if (GA.creds[validCredCount - 1].credential.user.id_size)
+    if (user.id_size)
     {
         map_size += 1;
     }
@@ -1150,36 +1478,26 @@ uint8_t ctap_get_assertion(CborEncoder * encoder, uint8_t * request, int length)
     ret = cbor_encoder_create_map(encoder, &map, map_size);
     check_ret(ret);
 
-    if (validCredCount == 0)
-    {
-        printf2(TAG_ERR,"Error, no authentic credential\n");
-        return CTAP2_ERR_NO_CREDENTIALS;
-    }
-
     // if only one account for this RP, null out the user details
     if (validCredCount < 2 || !getAssertionState.user_verified)
     {
         printf1(TAG_GREEN, "Only one account, nulling out user details on response\r\n");
-        memset(&GA.creds[0].credential.user.name, 0, USER_NAME_LIMIT);
+        memset(user.name, 0, USER_NAME_LIMIT);
     }
 
     printf1(TAG_GA,"resulting order of creds:\n");
     int j;
-    for (j = 0; j < GA.credLen; j++)
+    for (j = 0; j < validCredCount; j++)
     {
-        printf1(TAG_GA,"CRED ID (# %d)\n", GA.creds[j].credential.id.count);
+        printf1(TAG_GA,"CRED ID (# %d)\n", creds[j].id.count);
     }
 
-
-
-    CTAP_credentialDescriptor * cred = &GA.creds[validCredCount - 1];
-
-    GA.extensions.hmac_secret.credential = &cred->credential;
+    GA.extensions.hmac_secret.credential = &cred->id;
 
     uint32_t auth_data_buf_sz = sizeof(auth_data_buf);
 
 #ifdef ENABLE_U2F_EXTENSIONS
-    if ( is_extension_request((uint8_t*)&GA.creds[validCredCount - 1].credential.id, sizeof(CredentialId)) )
+    if ( is_extension_request((uint8_t*)&cred->id, sizeof(CredentialId)) )
     {
         ret = cbor_encode_int(&map,RESP_authData);  // 2
         check_ret(ret);
@@ -1211,9 +1529,11 @@ uint8_t ctap_get_assertion(CborEncoder * encoder, uint8_t * request, int length)
 
     }
 
-    save_credential_list((CTAP_authDataHeader*)auth_data_buf, GA.clientDataHash, GA.creds, validCredCount-1);   // skip last one
+    save_credential_list((CTAP_authDataHeader*)auth_data_buf, GA.clientDataHash, validCredCount-1);   // skip last one
+
+    sigder_sz = ctap_sign_assertion(cred, (CTAP_authDataHeader*)auth_data_buf, GA.clientDataHash, sigder);
 
-    ret = ctap_end_get_assertion(&map, cred, auth_data_buf, auth_data_buf_sz, GA.clientDataHash);  // 1,2,3,4
+    ret = ctap_end_get_assertion(&map, cred, &user, auth_data_buf, auth_data_buf_sz, sigder, sigder_sz);  // 1,2,3,4
     check_retr(ret);
 
     if (validCredCount > 1)
@@ -1265,11 +1585,7 @@ uint8_t ctap_update_pin_if_verified(uint8_t * pinEnc, int len, uint8_t * platfor
         }
     }
 
-    crypto_ecc256_shared_secret(platform_pubkey, KEY_AGREEMENT_PRIV, shared_secret);
-
-    crypto_sha256_init();
-    crypto_sha256_update(shared_secret, 32);
-    crypto_sha256_final(shared_secret);
+    ctap_platform_shared_secret(platform_pubkey, shared_secret);
 
     crypto_sha256_hmac_init(shared_secret, 32, hmac);
     crypto_sha256_update(pinEnc, len);
@@ -1349,11 +1665,7 @@ uint8_t ctap_add_pin_if_verified(uint8_t * pinTokenEnc, uint8_t * platform_pubke
 {
     uint8_t shared_secret[32];
 
-    crypto_ecc256_shared_secret(platform_pubkey, KEY_AGREEMENT_PRIV, shared_secret);
-
-    crypto_sha256_init();
-    crypto_sha256_update(shared_secret, 32);
-    crypto_sha256_final(shared_secret);
+    ctap_platform_shared_secret(platform_pubkey, shared_secret);
 
     crypto_aes256_init(shared_secret, NULL);
 
@@ -1596,9 +1908,7 @@ uint8_t ctap_request(uint8_t * pkt_raw, int length, CTAP_RESPONSE * resp)
             break;
         case CTAP_GET_INFO:
             printf1(TAG_CTAP,"CTAP_GET_INFO\n");
-            status = ctap_get_info(&encoder);
-
-            resp->length = cbor_encoder_get_buffer_size(&encoder, buf);
+            status = ctap_get_info(buf, resp->data_size, &resp->length);
 
             dump_hex1(TAG_DUMP, buf, resp->length);
 
@@ -1708,6 +2018,9 @@ void ctap_init()
 
     crypto_load_master_secret(STATE.key_space);
 
+    rk_index_build();
+    ctap_cache_info();
+
     if (ctap_is_pin_set())
     {
         printf1(TAG_STOR,"pin code: \"%s\"\n", STATE.pin_code);
@@ -1771,6 +2084,7 @@ void ctap_update_pin(uint8_t * pin, int len)
     crypto_sha256_final(PIN_CODE_HASH);
 
     STATE.is_pin_set = 1;
+    ctap_cache_info_pin();
 
     authenticator_write_state(&STATE, 1);
     authenticator_write_state(&STATE, 0);
@@ -1830,6 +2144,9 @@ void ctap_reset_pin_attempts()
 void ctap_reset_state()
 {
     memset(&getAssertionState, 0, sizeof(getAssertionState));
+#if NEXT_ASSERTION_PRECOMPUTE > 0
+    memset(nextAssertionSigs, 0, sizeof(nextAssertionSigs));
+#endif
 }
 
 uint16_t ctap_keys_stored()
@@ -1933,12 +2250,14 @@ int8_t ctap_load_key(uint8_t index, uint8_t * key)
 
 static void ctap_reset_key_agreement()
 {
+    memset(&SHARED_SECRET_CACHE, 0, sizeof(SHARED_SECRET_CACHE));
     crypto_ecc256_make_key_pair(KEY_AGREEMENT_PUB, KEY_AGREEMENT_PRIV);
 }
 
 void ctap_reset()
 {
     ctap_state_init();
+    ctap_cache_info_pin();
 
     authenticator_write_state(&STATE, 0);
     authenticator_write_state(&STATE, 1);
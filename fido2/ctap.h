@@ -9,6 +9,12 @@
 
 #include "cbor.h"
 
+// Storage class of the authenticator's global state.  The PC build makes it
+// thread local so one process can host several authenticators.
+#ifndef AUTHENTICATOR_LOCAL
+#define AUTHENTICATOR_LOCAL
+#endif
+
 #define CTAP_MAKE_CREDENTIAL        0x01
 #define CTAP_GET_ASSERTION          0x02
 #define CTAP_CANCEL                 0x03
@@ -118,6 +124,9 @@
 #define CREDENTIAL_NOT_SUPPORTED    0
 
 #define ALLOW_LIST_MAX_SIZE         20
+#define NEXT_ASSERTION_TIMEOUT      30000   // ms a getNextAssertion may follow the last one
+
+#define RK_INDEX_SIZE               64      // resident keys indexed in RAM, the rest are scanned
 
 #define NEW_PIN_ENC_MAX_SIZE        256     // includes NULL terminator
 #define NEW_PIN_ENC_MIN_SIZE        64
@@ -129,6 +138,15 @@
 #define PIN_LOCKOUT_ATTEMPTS        8       // Number of attempts total
 #define PIN_BOOT_ATTEMPTS           3       // number of attempts per boot
 
+// Bytes of the request being handled, which stays put in the CTAPHID (or
+// NFC) buffer until the response is sent.  Anything kept longer than that
+// is copied out.
+typedef struct
+{
+    const uint8_t * ptr;
+    size_t size;
+} CTAP_view;
+
 typedef struct
 {
     uint8_t id[USER_ID_MAX_SIZE];
@@ -151,12 +169,23 @@ struct Credential {
 };
 typedef struct Credential CTAP_residentKey;
 
+// A credential getAssertion may answer with.  The user of a resident key
+// stays in the store until its credential is the one returned.
 typedef struct
 {
+    CredentialId id;
     uint8_t type;
-    struct Credential credential;
+    int16_t rk;         // index of its resident key, or -1
 } CTAP_credentialDescriptor;
 
+// A credential descriptor of a request.  @id is NULL if the id isn't
+// sizeof(CredentialId) bytes, so can't be one of ours.
+typedef struct
+{
+    uint8_t type;
+    const CredentialId * id;
+} CTAP_credentialView;
+
 typedef struct
 {
     uint8_t aaguid[16];
@@ -187,7 +216,7 @@ typedef struct
 
 struct rpId
 {
-    uint8_t id[DOMAIN_NAME_MAX_SIZE + 1];     // extra for NULL termination
+    const uint8_t * id;     // in the request, not NULL terminated
     size_t size;
     uint8_t name[RP_NAME_LIMIT];
 };
@@ -209,7 +238,7 @@ typedef struct
     uint8_t saltEnc[64];
     uint8_t saltAuth[32];
     COSE_key keyAgreement;
-    struct Credential * credential;
+    CredentialId * credential;
 } CTAP_hmac_secret;
 
 typedef struct
@@ -218,9 +247,19 @@ typedef struct
     CTAP_hmac_secret hmac_secret;
 } CTAP_extensions;
 
+// The user entity of makeCredential, only copied if it is kept as a
+// resident key
 typedef struct
 {
-    CTAP_userEntity user;
+    CTAP_view id;
+    CTAP_view name;
+    CTAP_view displayName;
+    CTAP_view icon;
+} CTAP_userView;
+
+typedef struct
+{
+    CTAP_userView user;
     uint8_t publicKeyCredentialType;
     int32_t COSEAlgorithmIdentifier;
     uint8_t rk;
@@ -267,7 +306,7 @@ typedef struct
     uint8_t pinAuthPresent;
     int pinProtocol;
 
-    CTAP_credentialDescriptor creds[ALLOW_LIST_MAX_SIZE];
+    CTAP_credentialView allowList[ALLOW_LIST_MAX_SIZE];
     uint8_t allowListPresent;
 
     CTAP_extensions extensions;
@@ -305,6 +344,15 @@ void ctap_init();
 // Resets state between different accesses of different applications
 void ctap_reset_state();
 
+// Sign getNextAssertion responses ahead of time when the main loop is idle.
+// ctap_idle() does at most one signature per call.
+void ctap_idle();
+// @return nonzero while ctap_idle() has work to do
+int ctap_idle_pending();
+// Forget the credentials left for getNextAssertion if they were found for a
+// getAssertion on channel @cid
+void ctap_cancel_next_assertions(uint32_t cid);
+
 uint8_t ctap_add_pin_if_verified(uint8_t * pinTokenEnc, uint8_t * platform_pubkey, uint8_t * pinHashEnc);
 uint8_t ctap_update_pin_if_verified(uint8_t * pinEnc, int len, uint8_t * platform_pubkey, uint8_t * pinAuth, uint8_t * pinHashEnc);
 
@@ -329,8 +377,8 @@ int8_t ctap_load_key(uint8_t index, uint8_t * key);
 uint16_t ctap_key_len(uint8_t index);
 
 #define PIN_TOKEN_SIZE      16
-extern uint8_t PIN_TOKEN[PIN_TOKEN_SIZE];
-extern uint8_t KEY_AGREEMENT_PUB[64];
+extern AUTHENTICATOR_LOCAL uint8_t PIN_TOKEN[PIN_TOKEN_SIZE];
+extern AUTHENTICATOR_LOCAL uint8_t KEY_AGREEMENT_PUB[64];
 
 
 #endif
@@ -74,10 +74,163 @@ const char * cbor_value_get_type_string(const CborValue *value)
 }
 
 
+// Requests are parsed in one pass.  Every parse_* function reads the value
+// at its iterator and leaves the iterator on the item after it, so nested
+// maps and arrays are not walked again to step over them.  Maps with text
+// string keys go through parse_map_key and a table of the keys they know.
+#define MAP_KEY_MAX_SIZE        16
+#define MAP_KEY_UNKNOWN         -1
+
+#define USER_id                 0
+#define USER_name               1
+#define USER_displayName        2
+#define USER_icon               3
+
+static const char * const user_keys[] = {
+    [USER_id] = "id",
+    [USER_name] = "name",
+    [USER_displayName] = "displayName",
+    [USER_icon] = "icon",
+};
+
+#define RP_id                   0
+#define RP_name                 1
+
+static const char * const rp_keys[] = {
+    [RP_id] = "id",
+    [RP_name] = "name",
+};
+
+#define OPTION_rk               0
+#define OPTION_uv               1
+#define OPTION_up               2
+
+static const char * const option_keys[] = {
+    [OPTION_rk] = "rk",
+    [OPTION_uv] = "uv",
+    [OPTION_up] = "up",
+};
+
+#define EXT_hmac_secret         0
+
+static const char * const extension_keys[] = {
+    [EXT_hmac_secret] = "hmac-secret",
+};
+
+// PublicKeyCredentialDescriptor and PublicKeyCredentialParameters
+#define CRED_id                 0
+#define CRED_type               1
+#define CRED_alg                2
+
+static const char * const cred_keys[] = {
+    [CRED_id] = "id",
+    [CRED_type] = "type",
+    [CRED_alg] = "alg",
+};
+
+#define KEYS(table)     table, sizeof(table)/sizeof(table[0])
+
+// Look up the text string key at @map in @keys and step @map on to its value.
+// Keys too long for any table are unknown.
+// @return 0 or a CTAP error, with the index of the key in @keys, or
+// MAP_KEY_UNKNOWN, in @index
+static uint8_t parse_map_key(CborValue * map, const char * const * keys, int count, int * index)
+{
+    char key[MAP_KEY_MAX_SIZE];
+    size_t sz = sizeof(key);
+    int ret;
+    int i;
+
+    *index = MAP_KEY_UNKNOWN;
+
+    if (cbor_value_get_type(map) != CborTextStringType)
+    {
+        printf2(TAG_ERR,"Error, expecting text string type for map key, got %s\n", cbor_value_get_type_string(map));
+        return CTAP2_ERR_INVALID_CBOR_TYPE;
+    }
+
+    ret = cbor_value_copy_text_string(map, key, &sz, NULL);
+    if (ret == CborNoError && sz < sizeof(key))
+    {
+        for (i = 0; i < count; i++)
+        {
+            if (strcmp(key, keys[i]) == 0)
+            {
+                *index = i;
+                break;
+            }
+        }
+        if (*index == MAP_KEY_UNKNOWN)
+        {
+            printf1(TAG_PARSE,"ignoring map key %s\n", key);
+        }
+    }
+    else if (ret != CborErrorOutOfMemory)
+    {
+        check_ret(ret);
+    }
+
+    ret = cbor_value_advance(map);
+    check_ret(ret);
+
+    return 0;
+}
+
+static uint8_t parse_int(CborValue * val, int * dst)
+{
+    int ret;
+    if (cbor_value_get_type(val) != CborIntegerType)
+    {
+        return CTAP2_ERR_INVALID_CBOR_TYPE;
+    }
+    ret = cbor_value_get_int_checked(val, dst);
+    check_ret(ret);
+    ret = cbor_value_advance(val);
+    check_ret(ret);
+    return 0;
+}
+
+// Copy a text string, truncated to fit @len bytes with the NULL terminator
+static uint8_t parse_text_string(CborValue * val, uint8_t * dst, size_t len)
+{
+    size_t sz = len;
+    int ret;
+    ret = cbor_value_copy_text_string(val, (char *)dst, &sz, NULL);
+    if (ret != CborErrorOutOfMemory)
+    {   // Just truncate the name it's okay
+        check_ret(ret);
+    }
+    dst[len - 1] = 0;
+    ret = cbor_value_advance(val);
+    check_ret(ret);
+    return 0;
+}
+
+// Point @view at the contents of the string @val, in the request buffer,
+// and advance past it.  Chunked strings aren't canonical CBOR, so aren't
+// worth gathering into a copy.
+static uint8_t parse_string_view(CborValue * val, CTAP_view * view)
+{
+    size_t sz;
+    int ret;
+    if (!cbor_value_is_length_known(val))
+    {
+        printf2(TAG_ERR,"Error, indefinite length string\n");
+        return CTAP2_ERR_INVALID_CBOR;
+    }
+    ret = cbor_value_get_string_length(val, &sz);
+    check_ret(ret);
+    ret = cbor_value_advance(val);
+    check_ret(ret);
+    view->ptr = cbor_value_get_next_byte(val) - sz;
+    view->size = sz;
+    return 0;
+}
+
 uint8_t parse_user(CTAP_makeCredential * MC, CborValue * val)
 {
-    size_t sz, map_length;
-    uint8_t key[24];
+    size_t map_length;
+    int key;
     int ret;
     unsigned int i;
     CborValue map;
@@ -97,103 +250,63 @@ uint8_t parse_user(CTAP_makeCredential * MC, CborValue * val)
 
     for (i = 0; i < map_length; i++)
     {
-        if (cbor_value_get_type(&map) != CborTextStringType)
-        {
-            printf2(TAG_ERR,"Error, expecting text string type for user map key, got %s\n", cbor_value_get_type_string(&map));
-            return CTAP2_ERR_INVALID_CBOR_TYPE;
-        }
-
-        sz = sizeof(key);
-        ret = cbor_value_copy_text_string(&map, (char *)key, &sz, NULL);
-
-        if (ret == CborErrorOutOfMemory)
-        {
-            printf2(TAG_ERR,"Error, rp map key is too large\n");
-            return CTAP2_ERR_LIMIT_EXCEEDED;
-        }
-
-        check_ret(ret);
-        key[sizeof(key) - 1] = 0;
-
-        ret = cbor_value_advance(&map);
-        check_ret(ret);
+        ret = parse_map_key(&map, KEYS(user_keys), &key);
+        check_retr(ret);
 
-        if (strcmp((const char*)key, "id") == 0)
+        switch(key)
         {
+            case USER_id:
+                if (cbor_value_get_type(&map) != CborByteStringType)
+                {
+                    printf2(TAG_ERR,"Error, expecting byte string type for rp map value\n");
+                    return CTAP2_ERR_INVALID_CBOR_TYPE;
+                }
 
-            if (cbor_value_get_type(&map) != CborByteStringType)
-            {
-                printf2(TAG_ERR,"Error, expecting byte string type for rp map value\n");
-                return CTAP2_ERR_INVALID_CBOR_TYPE;
-            }
-
-            sz = USER_ID_MAX_SIZE;
-            ret = cbor_value_copy_byte_string(&map, MC->credInfo.user.id, &sz, NULL);
-            if (ret == CborErrorOutOfMemory)
-            {
-                printf2(TAG_ERR,"Error, USER_ID is too large\n");
-                return CTAP2_ERR_LIMIT_EXCEEDED;
-            }
-            MC->credInfo.user.id_size = sz;
-            printf1(TAG_GREEN,"parsed id_size: %d\r\n", MC->credInfo.user.id_size);
-            check_ret(ret);
-        }
-        else if (strcmp((const char *)key, "name") == 0)
-        {
-            if (cbor_value_get_type(&map) != CborTextStringType)
-            {
-                printf2(TAG_ERR,"Error, expecting text string type for user.name value\n");
-                return CTAP2_ERR_INVALID_CBOR_TYPE;
-            }
-            sz = USER_NAME_LIMIT;
-            ret = cbor_value_copy_text_string(&map, (char *)MC->credInfo.user.name, &sz, NULL);
-            if (ret != CborErrorOutOfMemory)
-            {   // Just truncate the name it's okay
-                check_ret(ret);
-            }
-            MC->credInfo.user.name[USER_NAME_LIMIT - 1] = 0;
-        }
-        else if (strcmp((const char *)key, "displayName") == 0)
-        {
-            if (cbor_value_get_type(&map) != CborTextStringType)
-            {
-                printf2(TAG_ERR,"Error, expecting text string type for user.displayName value\n");
-                return CTAP2_ERR_INVALID_CBOR_TYPE;
-            }
-            sz = DISPLAY_NAME_LIMIT;
-            ret = cbor_value_copy_text_string(&map, (char *)MC->credInfo.user.displayName, &sz, NULL);
-            if (ret != CborErrorOutOfMemory)
-            {   // Just truncate the name it's okay
-                check_ret(ret);
-            }
-            MC->credInfo.user.displayName[DISPLAY_NAME_LIMIT - 1] = 0;
-        }
-        else if (strcmp((const char *)key, "icon") == 0)
-        {
-            if (cbor_value_get_type(&map) != CborTextStringType)
-            {
-                printf2(TAG_ERR,"Error, expecting text string type for user.icon value\n");
-                return CTAP2_ERR_INVALID_CBOR_TYPE;
-            }
-            sz = ICON_LIMIT;
-            ret = cbor_value_copy_text_string(&map, (char *)MC->credInfo.user.icon, &sz, NULL);
-            if (ret != CborErrorOutOfMemory)
-            {   // Just truncate the name it's okay
+                ret = parse_string_view(&map, &MC->credInfo.user.id);
+                check_retr(ret);
+                if (MC->credInfo.user.id.size > USER_ID_MAX_SIZE)
+                {
+                    printf2(TAG_ERR,"Error, USER_ID is too large\n");
+                    return CTAP2_ERR_LIMIT_EXCEEDED;
+                }
+                printf1(TAG_GREEN,"parsed id_size: %d\r\n", (int)MC->credInfo.user.id.size);
+                break;
+            case USER_name:
+                if (cbor_value_get_type(&map) != CborTextStringType)
+                {
+                    printf2(TAG_ERR,"Error, expecting text string type for user.name value\n");
+                    return CTAP2_ERR_INVALID_CBOR_TYPE;
+                }
+                ret = parse_string_view(&map, &MC->credInfo.user.name);
+                check_retr(ret);
+                break;
+            case USER_displayName:
+                if (cbor_value_get_type(&map) != CborTextStringType)
+                {
+                    printf2(TAG_ERR,"Error, expecting text string type for user.displayName value\n");
+                    return CTAP2_ERR_INVALID_CBOR_TYPE;
+                }
+                ret = parse_string_view(&map, &MC->credInfo.user.displayName);
+                check_retr(ret);
+                break;
+            case USER_icon:
+                if (cbor_value_get_type(&map) != CborTextStringType)
+                {
+                    printf2(TAG_ERR,"Error, expecting text string type for user.icon value\n");
+                    return CTAP2_ERR_INVALID_CBOR_TYPE;
+                }
+                ret = parse_string_view(&map, &MC->credInfo.user.icon);
+                check_retr(ret);
+                break;
+            default:
+                ret = cbor_value_advance(&map);
                 check_ret(ret);
-            }
-            MC->credInfo.user.icon[ICON_LIMIT - 1] = 0;
-
         }
-        else
-        {
-            printf1(TAG_PARSE,"ignoring key %s for user map\n", key);
-        }
-
-        ret = cbor_value_advance(&map);
-        check_ret(ret);
-
     }
 
+    ret = cbor_value_leave_container(val, &map);
+    check_ret(ret);
+
     MC->paramsParsed |= PARAM_user;
 
     return 0;
@@ -202,11 +315,14 @@ uint8_t parse_user(CTAP_makeCredential * MC, CborValue * val)
 
 uint8_t parse_pub_key_cred_param(CborValue * val, uint8_t * cred_type, int32_t * alg_type)
 {
-    CborValue cred;
-    CborValue alg;
+    CborValue map;
+    size_t map_length;
+    int key;
     int ret;
+    unsigned int i;
     uint8_t type_str[16];
-    size_t sz = sizeof(type_str);
+    size_t sz;
+    uint8_t found_type = 0, found_alg = 0;
 
     if (cbor_value_get_type(val) != CborMapType)
     {
@@ -214,37 +330,58 @@ uint8_t parse_pub_key_cred_param(CborValue * val, uint8_t * cred_type, int32_t *
         return CTAP2_ERR_INVALID_CBOR_TYPE;
     }
 
-    ret = cbor_value_map_find_value(val, "type", &cred);
+    ret = cbor_value_enter_container(val,&map);
     check_ret(ret);
-    ret = cbor_value_map_find_value(val, "alg", &alg);
+
+    ret = cbor_value_get_map_length(val, &map_length);
     check_ret(ret);
 
-    if (cbor_value_get_type(&cred) != CborTextStringType)
-    {
-        printf2(TAG_ERR,"Error, parse_pub_key could not find credential param\n");
-        return CTAP2_ERR_MISSING_PARAMETER;
-    }
-    if (cbor_value_get_type(&alg) != CborIntegerType)
+    for (i = 0; i < map_length; i++)
     {
-        printf2(TAG_ERR,"Error, parse_pub_key could not find alg param\n");
-        return CTAP2_ERR_MISSING_PARAMETER;
-    }
+        ret = parse_map_key(&map, KEYS(cred_keys), &key);
+        check_retr(ret);
 
-    ret = cbor_value_copy_text_string(&cred, (char*)type_str, &sz, NULL);
-    check_ret(ret);
+        if (key == CRED_type && cbor_value_get_type(&map) == CborTextStringType)
+        {
+            sz = sizeof(type_str);
+            ret = cbor_value_copy_text_string(&map, (char*)type_str, &sz, NULL);
+            check_ret(ret);
 
-    type_str[sizeof(type_str) - 1] = 0;
+            type_str[sizeof(type_str) - 1] = 0;
 
-    if (strcmp((const char*)type_str, "public-key") == 0)
+            if (strcmp((const char*)type_str, "public-key") == 0)
+            {
+                *cred_type = PUB_KEY_CRED_PUB_KEY;
+            }
+            else
+            {
+                *cred_type = PUB_KEY_CRED_UNKNOWN;
+            }
+            found_type = 1;
+        }
+        else if (key == CRED_alg && cbor_value_get_type(&map) == CborIntegerType)
+        {
+            ret = cbor_value_get_int_checked(&map, (int*)alg_type);
+            check_ret(ret);
+            found_alg = 1;
+        }
+
+        ret = cbor_value_advance(&map);
+        check_ret(ret);
+    }
+
+    if (!found_type)
     {
-        *cred_type = PUB_KEY_CRED_PUB_KEY;
+        printf2(TAG_ERR,"Error, parse_pub_key could not find credential param\n");
+        return CTAP2_ERR_MISSING_PARAMETER;
     }
-    else
+    if (!found_alg)
     {
-        *cred_type = PUB_KEY_CRED_UNKNOWN;
+        printf2(TAG_ERR,"Error, parse_pub_key could not find alg param\n");
+        return CTAP2_ERR_MISSING_PARAMETER;
     }
 
-    ret = cbor_value_get_int_checked(&alg, (int*)alg_type);
+    ret = cbor_value_leave_container(val, &map);
     check_ret(ret);
 
     return 0;
@@ -286,37 +423,32 @@ uint8_t parse_pub_key_cred_params(CTAP_makeCredential * MC, CborValue * val)
     ret = cbor_value_get_array_length(val, &arr_length);
     check_ret(ret);
 
+    // Every entry must be well formed, and the first supported one is used
     for (i = 0; i < arr_length; i++)
     {
         if ((ret = parse_pub_key_cred_param(&arr, &cred_type, &alg_type)) != 0)
         {
             return ret;
         }
-        ret = cbor_value_advance(&arr);
-        check_ret(ret);
+        if (!(MC->paramsParsed & PARAM_pubKeyCredParams) &&
+            pub_key_cred_param_supported(cred_type, alg_type) == CREDENTIAL_IS_SUPPORTED)
+        {
+            MC->credInfo.publicKeyCredentialType = cred_type;
+            MC->credInfo.COSEAlgorithmIdentifier = alg_type;
+            MC->paramsParsed |= PARAM_pubKeyCredParams;
+        }
     }
 
-    ret = cbor_value_enter_container(val,&arr);
-    check_ret(ret);
-
-    for (i = 0; i < arr_length; i++)
+    if (!(MC->paramsParsed & PARAM_pubKeyCredParams))
     {
-        if ((ret = parse_pub_key_cred_param(&arr, &cred_type, &alg_type)) == 0)
-        {
-            if (pub_key_cred_param_supported(cred_type, alg_type) == CREDENTIAL_IS_SUPPORTED)
-            {
-                MC->credInfo.publicKeyCredentialType = cred_type;
-                MC->credInfo.COSEAlgorithmIdentifier = alg_type;
-                MC->paramsParsed |= PARAM_pubKeyCredParams;
-                return 0;
-            }
-        }
-        ret = cbor_value_advance(&arr);
-        check_ret(ret);
+        printf2(TAG_ERR,"Error, no public key credential parameters are supported!\n");
+        return CTAP2_ERR_UNSUPPORTED_ALGORITHM;
     }
 
-    printf2(TAG_ERR,"Error, no public key credential parameters are supported!\n");
-    return CTAP2_ERR_UNSUPPORTED_ALGORITHM;
+    ret = cbor_value_leave_container(val, &arr);
+    check_ret(ret);
+
+    return 0;
 }
 
 uint8_t parse_fixed_byte_string(CborValue * map, uint8_t * dst, unsigned int len)
@@ -328,6 +460,8 @@ uint8_t parse_fixed_byte_string(CborValue * map, uint8_t * dst, unsigned int len
         sz = len;
         ret = cbor_value_copy_byte_string(map, dst, &sz, NULL);
         check_ret(ret);
+        ret = cbor_value_advance(map);
+        check_ret(ret);
         if (sz != len)
         {
             printf2(TAG_ERR, "error byte string is different length (%d vs %d)\r\n", len, sz);
@@ -348,7 +482,7 @@ uint8_t parse_verify_exclude_list(CborValue * val)
     int ret;
     CborValue arr;
     size_t size;
-    CTAP_credentialDescriptor cred;
+    CTAP_credentialView cred;
     if (cbor_value_get_type(val) != CborArrayType)
     {
         printf2(TAG_ERR,"error, exclude list is not a map\n");
@@ -362,36 +496,35 @@ uint8_t parse_verify_exclude_list(CborValue * val)
     {
         ret = parse_credential_descriptor(&arr, &cred);
         check_ret(ret);
-        ret = cbor_value_advance(&arr);
-        check_ret(ret);
-
     }
+    ret = cbor_value_leave_container(val, &arr);
+    check_ret(ret);
     return 0;
 }
 
 uint8_t parse_rp_id(struct rpId * rp, CborValue * val)
 {
-    size_t sz = DOMAIN_NAME_MAX_SIZE;
+    CTAP_view id;
     if (cbor_value_get_type(val) != CborTextStringType)
     {
         return CTAP2_ERR_INVALID_CBOR_TYPE;
     }
-    int ret = cbor_value_copy_text_string(val, (char*)rp->id, &sz, NULL);
-    if (ret == CborErrorOutOfMemory)
+    int ret = parse_string_view(val, &id);
+    check_retr(ret);
+    if (id.size > DOMAIN_NAME_MAX_SIZE)
     {
         printf2(TAG_ERR,"Error, RP_ID is too large\n");
         return CTAP2_ERR_LIMIT_EXCEEDED;
     }
-    check_ret(ret);
-    rp->id[DOMAIN_NAME_MAX_SIZE] = 0;     // Extra byte defined in struct.
-    rp->size = sz;
+    rp->id = id.ptr;
+    rp->size = id.size;
     return 0;
 }
 
 uint8_t parse_rp(struct rpId * rp, CborValue * val)
 {
-    size_t sz, map_length;
-    char key[8];
+    size_t map_length;
+    int key;
     int ret;
     unsigned int i;
     CborValue map;
@@ -413,25 +546,8 @@ uint8_t parse_rp(struct rpId * rp, CborValue * val)
 
     for (i = 0; i < map_length; i++)
     {
-        if (cbor_value_get_type(&map) != CborTextStringType)
-        {
-            printf2(TAG_ERR,"Error, expecting text string type for rp map key, got %s\n", cbor_value_get_type_string(&map));
-            return CTAP2_ERR_INVALID_CBOR_TYPE;
-        }
-
-        sz = sizeof(key);
-        ret = cbor_value_copy_text_string(&map, key, &sz, NULL);
-
-        if (ret == CborErrorOutOfMemory)
-        {
-            printf2(TAG_ERR,"Error, rp map key is too large\n");
-            return CTAP2_ERR_LIMIT_EXCEEDED;
-        }
-        check_ret(ret);
-        key[sizeof(key) - 1] = 0;
-
-        ret = cbor_value_advance(&map);
-        check_ret(ret);
+        ret = parse_map_key(&map, KEYS(rp_keys), &key);
+        check_retr(ret);
 
         if (cbor_value_get_type(&map) != CborTextStringType)
         {
@@ -439,32 +555,23 @@ uint8_t parse_rp(struct rpId * rp, CborValue * val)
             return CTAP2_ERR_INVALID_CBOR_TYPE;
         }
 
-        if (strcmp(key, "id") == 0)
-        {
-            ret = parse_rp_id(rp, &map);
-            if (ret != 0)
-            {
-                return ret;
-            }
-        }
-        else if (strcmp(key, "name") == 0)
+        switch(key)
         {
-            sz = RP_NAME_LIMIT;
-            ret = cbor_value_copy_text_string(&map, (char*)rp->name, &sz, NULL);
-            if (ret != CborErrorOutOfMemory)
-            {   // Just truncate the name it's okay
+            case RP_id:
+                ret = parse_rp_id(rp, &map);
+                if (ret != 0)
+                {
+                    return ret;
+                }
+                break;
+            case RP_name:
+                ret = parse_text_string(&map, rp->name, RP_NAME_LIMIT);
+                check_retr(ret);
+                break;
+            default:
+                ret = cbor_value_advance(&map);
                 check_ret(ret);
-            }
-            rp->name[RP_NAME_LIMIT - 1] = 0;
-        }
-        else
-        {
-            printf1(TAG_PARSE,"ignoring key %s for RP map\n", key);
         }
-
-        ret = cbor_value_advance(&map);
-        check_ret(ret);
-
     }
     if (rp->size == 0)
     {
@@ -472,14 +579,16 @@ uint8_t parse_rp(struct rpId * rp, CborValue * val)
         return CTAP2_ERR_MISSING_PARAMETER;
     }
 
+    ret = cbor_value_leave_container(val, &map);
+    check_ret(ret);
 
     return 0;
 }
 
 uint8_t parse_options(CborValue * val, uint8_t * rk, uint8_t * uv, uint8_t * up)
 {
-    size_t sz, map_length;
-    char key[8];
+    size_t map_length;
+    int key;
     int ret;
     unsigned int i;
     _Bool b;
@@ -500,24 +609,8 @@ uint8_t parse_options(CborValue * val, uint8_t * rk, uint8_t * uv, uint8_t * up)
 
     for (i = 0; i < map_length; i++)
     {
-        if (cbor_value_get_type(&map) != CborTextStringType)
-        {
-            printf2(TAG_ERR,"Error, expecting text string type for options map key, got %s\n", cbor_value_get_type_string(&map));
-            return CTAP2_ERR_INVALID_CBOR_TYPE;
-        }
-        sz = sizeof(key);
-        ret = cbor_value_copy_text_string(&map, key, &sz, NULL);
-
-        if (ret == CborErrorOutOfMemory)
-        {
-            printf2(TAG_ERR,"Error, rp map key is too large\n");
-            return CTAP2_ERR_LIMIT_EXCEEDED;
-        }
-        check_ret(ret);
-        key[sizeof(key) - 1] = 0;
-
-        ret = cbor_value_advance(&map);
-        check_ret(ret);
+        ret = parse_map_key(&map, KEYS(option_keys), &key);
+        check_retr(ret);
 
         if (cbor_value_get_type(&map) != CborBooleanType)
         {
@@ -525,34 +618,32 @@ uint8_t parse_options(CborValue * val, uint8_t * rk, uint8_t * uv, uint8_t * up)
             return CTAP2_ERR_INVALID_CBOR_TYPE;
         }
 
-        if (strncmp(key, "rk",2) == 0)
-        {
-            ret = cbor_value_get_boolean(&map, &b);
-            check_ret(ret);
-            printf1(TAG_GA, "rk: %d\r\n",b);
-            *rk = b;
-        }
-        else if (strncmp(key, "uv",2) == 0)
-        {
-            ret = cbor_value_get_boolean(&map, &b);
-            check_ret(ret);
-            printf1(TAG_GA, "uv: %d\r\n",b);
-            *uv = b;
-        }
-        else if (strncmp(key, "up",2) == 0)
-        {
-            ret = cbor_value_get_boolean(&map, &b);
-            check_ret(ret);
-            printf1(TAG_GA, "up: %d\r\n",b);
-            *up = b;
-        }
-        else
+        ret = cbor_value_get_boolean(&map, &b);
+        check_ret(ret);
+
+        switch(key)
         {
-            printf2(TAG_PARSE,"ignoring option specified %s\n", key);
+            case OPTION_rk:
+                printf1(TAG_GA, "rk: %d\r\n",b);
+                *rk = b;
+                break;
+            case OPTION_uv:
+                printf1(TAG_GA, "uv: %d\r\n",b);
+                *uv = b;
+                break;
+            case OPTION_up:
+                printf1(TAG_GA, "up: %d\r\n",b);
+                *up = b;
+                break;
         }
+
         ret = cbor_value_advance(&map);
         check_ret(ret);
     }
+
+    ret = cbor_value_leave_container(val, &map);
+    check_ret(ret);
+
     return 0;
 }
 
@@ -608,17 +699,21 @@ uint8_t ctap_parse_hmac_secret(CborValue * val, CTAP_hmac_secret * hs)
                 check_ret(ret);
                 hs->saltLen = salt_len;
                 parsed_count++;
+                ret = cbor_value_advance(&map);
+                check_ret(ret);
             break;
             case EXT_HMAC_SECRET_SALT_AUTH:
                 salt_len = 32;
                 ret = cbor_value_copy_byte_string(&map, hs->saltAuth, &salt_len, NULL);
                 check_ret(ret);
                 parsed_count++;
+                ret = cbor_value_advance(&map);
+                check_ret(ret);
             break;
+            default:
+                ret = cbor_value_advance(&map);
+                check_ret(ret);
         }
-
-        ret = cbor_value_advance(&map);
-        check_ret(ret);
     }
 
     if (parsed_count != 3)
@@ -627,6 +722,9 @@ uint8_t ctap_parse_hmac_secret(CborValue * val, CTAP_hmac_secret * hs)
         return CTAP2_ERR_MISSING_PARAMETER;
     }
 
+    ret = cbor_value_leave_container(val, &map);
+    check_ret(ret);
+
     return 0;
 }
 
@@ -634,8 +732,8 @@ uint8_t ctap_parse_hmac_secret(CborValue * val, CTAP_hmac_secret * hs)
 uint8_t ctap_parse_extensions(CborValue * val, CTAP_extensions * ext)
 {
     CborValue map;
-    size_t sz, map_length;
-    char key[16];
+    size_t map_length;
+    int key;
     int ret;
     unsigned int i;
     bool b;
@@ -654,53 +752,38 @@ uint8_t ctap_parse_extensions(CborValue * val, CTAP_extensions * ext)
 
     for (i = 0; i < map_length; i++)
     {
-        if (cbor_value_get_type(&map) != CborTextStringType)
-        {
-            printf2(TAG_ERR,"Error, expecting text string type for options map key, got %s\n", cbor_value_get_type_string(&map));
-            return CTAP2_ERR_INVALID_CBOR_TYPE;
-        }
-        sz = sizeof(key);
-        ret = cbor_value_copy_text_string(&map, key, &sz, NULL);
+        ret = parse_map_key(&map, KEYS(extension_keys), &key);
+        check_retr(ret);
 
-        if (ret == CborErrorOutOfMemory)
+        if (key == EXT_hmac_secret && cbor_value_get_type(&map) == CborMapType)
         {
-            printf2(TAG_ERR,"Error, rp map key is too large. Ignoring.\n");
-            cbor_value_advance(&map);
-            cbor_value_advance(&map);
-            continue;
+            ret = ctap_parse_hmac_secret(&map, &ext->hmac_secret);
+            check_retr(ret);
+            ext->hmac_secret_present = EXT_HMAC_SECRET_PARSED;
+            printf1(TAG_CTAP, "parsed hmac_secret request\r\n");
         }
-        check_ret(ret);
-        key[sizeof(key) - 1] = 0;
-
-        ret = cbor_value_advance(&map);
-        check_ret(ret);
-
-
-        if (strncmp(key, "hmac-secret",11) == 0)
+        else
         {
-            if (cbor_value_get_type(&map) == CborBooleanType)
+            if (key == EXT_hmac_secret && cbor_value_get_type(&map) == CborBooleanType)
             {
                 ret = cbor_value_get_boolean(&map, &b);
                 check_ret(ret);
                 if (b) ext->hmac_secret_present = EXT_HMAC_SECRET_REQUESTED;
                 printf1(TAG_CTAP, "set hmac_secret_present to %d\r\n", b);
             }
-            else if (cbor_value_get_type(&map) == CborMapType)
-            {
-                ret = ctap_parse_hmac_secret(&map, &ext->hmac_secret);
-                check_retr(ret);
-                ext->hmac_secret_present = EXT_HMAC_SECRET_PARSED;
-                printf1(TAG_CTAP, "parsed hmac_secret request\r\n");
-            }
-            else
+            else if (key == EXT_hmac_secret)
             {
                 printf1(TAG_RED, "warning: hmac_secret request ignored for being wrong type\r\n");
             }
-        }
 
-        ret = cbor_value_advance(&map);
-        check_ret(ret);
+            ret = cbor_value_advance(&map);
+            check_ret(ret);
+        }
     }
+
+    ret = cbor_value_leave_container(val, &map);
+    check_ret(ret);
+
     return 0;
 }
 
@@ -711,7 +794,7 @@ uint8_t ctap_parse_make_credential(CTAP_makeCredential * MC, CborEncoder * encod
     int key;
     size_t map_length;
     CborParser parser;
-    CborValue it,map;
+    CborValue it,map,list;
 
     memset(MC, 0, sizeof(CTAP_makeCredential));
     ret = cbor_parser_init(request, length, CborValidateCanonicalFormat, &parser, &it);
@@ -771,7 +854,7 @@ uint8_t ctap_parse_make_credential(CTAP_makeCredential * MC, CborEncoder * encod
                 }
 
 
-                printf1(TAG_MC,"  ID: %s\n", MC->rp.id);
+                printf1(TAG_MC,"  ID: %.*s\n", (int)MC->rp.size, MC->rp.id);
                 printf1(TAG_MC,"  name: %s\n", MC->rp.name);
                 break;
             case MC_user:
@@ -779,8 +862,8 @@ uint8_t ctap_parse_make_credential(CTAP_makeCredential * MC, CborEncoder * encod
 
                 ret = parse_user(MC, &map);
 
-                printf1(TAG_MC,"  ID: "); dump_hex1(TAG_MC, MC->credInfo.user.id, MC->credInfo.user.id_size);
-                printf1(TAG_MC,"  name: %s\n", MC->credInfo.user.name);
+                printf1(TAG_MC,"  ID: "); dump_hex1(TAG_MC, (uint8_t*)MC->credInfo.user.id.ptr, MC->credInfo.user.id.size);
+                printf1(TAG_MC,"  name: %.*s\n", (int)MC->credInfo.user.name.size, MC->credInfo.user.name.ptr);
 
                 break;
             case MC_pubKeyCredParams:
@@ -794,13 +877,14 @@ uint8_t ctap_parse_make_credential(CTAP_makeCredential * MC, CborEncoder * encod
                 break;
             case MC_excludeList:
                 printf1(TAG_MC,"CTAP_excludeList\n");
+                list = map;
                 ret = parse_verify_exclude_list(&map);
                 check_ret(ret);
 
-                ret = cbor_value_enter_container(&map, &MC->excludeList);
+                ret = cbor_value_enter_container(&list, &MC->excludeList);
                 check_ret(ret);
 
-                ret = cbor_value_get_array_length(&map, &MC->excludeListSize);
+                ret = cbor_value_get_array_length(&list, &MC->excludeListSize);
                 check_ret(ret);
 
 
@@ -839,85 +923,102 @@ uint8_t ctap_parse_make_credential(CTAP_makeCredential * MC, CborEncoder * encod
                 break;
             case MC_pinProtocol:
                 printf1(TAG_MC,"CTAP_pinProtocol\n");
-                if (cbor_value_get_type(&map) == CborIntegerType)
-                {
-                    ret = cbor_value_get_int_checked(&map, &MC->pinProtocol);
-                    check_ret(ret);
-                    printf1(TAG_MC," == %d\n",MC->pinProtocol);
-                }
-                else
-                {
-                    return CTAP2_ERR_INVALID_CBOR_TYPE;
-                }
-
+                ret = parse_int(&map, &MC->pinProtocol);
+                check_retr(ret);
+                printf1(TAG_MC," == %d\n",MC->pinProtocol);
                 break;
 
             default:
                 printf1(TAG_MC,"invalid key %d\n", key);
+                ret = cbor_value_advance(&map);
+                check_ret(ret);
 
         }
         if (ret != 0)
         {
             return ret;
         }
-        cbor_value_advance(&map);
-        check_ret(ret);
     }
 
     return 0;
 }
 
-uint8_t parse_credential_descriptor(CborValue * arr, CTAP_credentialDescriptor * cred)
+uint8_t parse_credential_descriptor(CborValue * arr, CTAP_credentialView * cred)
 {
     int ret;
-    size_t buflen;
-    char type[12];
-    CborValue val;
+    int key;
+    unsigned int i;
+    size_t map_length;
+    CTAP_view id, type;
+    uint8_t found_id = 0, found_type = 0;
+    CborValue map;
     if (cbor_value_get_type(arr) != CborMapType)
     {
         printf2(TAG_ERR,"Error, CborMapType expected in credential\n");
         return CTAP2_ERR_INVALID_CBOR_TYPE;
     }
 
-    ret = cbor_value_map_find_value(arr, "id", &val);
+    ret = cbor_value_enter_container(arr,&map);
     check_ret(ret);
 
-    if (cbor_value_get_type(&val) != CborByteStringType)
-    {
-        printf2(TAG_ERR,"Error, No valid ID field (%s)\n", cbor_value_get_type_string(&val));
-        return CTAP2_ERR_MISSING_PARAMETER;
-    }
+    ret = cbor_value_get_map_length(arr, &map_length);
+    check_ret(ret);
 
-    buflen = sizeof(CredentialId);
-    cbor_value_copy_byte_string(&val, (uint8_t*)&cred->credential.id, &buflen, NULL);
-    if (buflen != sizeof(CredentialId))
+    for (i = 0; i < map_length; i++)
     {
-        printf2(TAG_ERR,"Ignoring credential is incorrect length\n");
-        //return CTAP2_ERR_CBOR_UNEXPECTED_TYPE; // maybe just skip it instead of fail?
-    }
+        ret = parse_map_key(&map, KEYS(cred_keys), &key);
+        check_retr(ret);
 
-    ret = cbor_value_map_find_value(arr, "type", &val);
-    check_ret(ret);
+        if (key == CRED_id && cbor_value_get_type(&map) == CborByteStringType)
+        {
+            ret = parse_string_view(&map, &id);
+            check_retr(ret);
+            // CredentialId is packed, so can be read in place
+            cred->id = (const CredentialId *)id.ptr;
+            if (id.size != sizeof(CredentialId))
+            {
+                printf2(TAG_ERR,"Ignoring credential is incorrect length\n");
+                cred->id = NULL;
+            }
+            found_id = 1;
+        }
+        else if (key == CRED_type && cbor_value_get_type(&map) == CborTextStringType)
+        {
+            ret = parse_string_view(&map, &type);
+            check_retr(ret);
 
-    if (cbor_value_get_type(&val) != CborTextStringType)
-    {
-        printf2(TAG_ERR,"Error, No valid type field\n");
-        return CTAP2_ERR_MISSING_PARAMETER;
+            if (type.size == 10 && memcmp(type.ptr, "public-key", 10) == 0)
+            {
+                cred->type = PUB_KEY_CRED_PUB_KEY;
+            }
+            else
+            {
+                cred->type = PUB_KEY_CRED_UNKNOWN;
+                printf1(TAG_RED, "Unknown type: %.*s\r\n", (int)type.size, type.ptr);
+            }
+            found_type = 1;
+        }
+        else
+        {
+            ret = cbor_value_advance(&map);
+            check_ret(ret);
+        }
     }
 
-    buflen = sizeof(type);
-    cbor_value_copy_text_string(&val, type, &buflen, NULL);
-
-    if (strncmp(type, "public-key",11) == 0)
+    if (!found_id)
     {
-        cred->type = PUB_KEY_CRED_PUB_KEY;
+        printf2(TAG_ERR,"Error, No valid ID field\n");
+        return CTAP2_ERR_MISSING_PARAMETER;
     }
-    else
+    if (!found_type)
     {
-        cred->type = PUB_KEY_CRED_UNKNOWN;
-        printf1(TAG_RED, "Unknown type: %s\r\n", type);
+        printf2(TAG_ERR,"Error, No valid type field\n");
+        return CTAP2_ERR_MISSING_PARAMETER;
     }
 
+    ret = cbor_value_leave_container(arr, &map);
+    check_ret(ret);
+
     return 0;
 }
 
@@ -927,7 +1028,6 @@ uint8_t parse_allow_list(CTAP_getAssertion * GA, CborValue * it)
     size_t len;
     int ret;
     unsigned int i;
-    CTAP_credentialDescriptor * cred;
 
     if (cbor_value_get_type(it) != CborArrayType)
     {
@@ -952,15 +1052,14 @@ uint8_t parse_allow_list(CTAP_getAssertion * GA, CborValue * it)
         }
 
         GA->credLen += 1;
-        cred = &GA->creds[i];
 
-        ret = parse_credential_descriptor(&arr,cred);
+        ret = parse_credential_descriptor(&arr, &GA->allowList[i]);
         check_retr(ret);
+    }
 
-        ret = cbor_value_advance(&arr);
-        check_ret(ret);
+    ret = cbor_value_leave_container(it, &arr);
+    check_ret(ret);
 
-    }
     return 0;
 }
 
@@ -1025,7 +1124,7 @@ uint8_t ctap_parse_get_assertion(CTAP_getAssertion * GA, uint8_t * request, int
 
                 ret = parse_rp_id(&GA->rp, &map);
 
-                printf1(TAG_GA,"  ID: %s\n", GA->rp.id);
+                printf1(TAG_GA,"  ID: %.*s\n", (int)GA->rp.size, GA->rp.id);
                 break;
             case GA_allowList:
                 printf1(TAG_GA,"GA_allowList\n");
@@ -1065,27 +1164,20 @@ uint8_t ctap_parse_get_assertion(CTAP_getAssertion * GA, uint8_t * request, int
                 break;
             case GA_pinProtocol:
                 printf1(TAG_GA,"CTAP_pinProtocol\n");
-                if (cbor_value_get_type(&map) == CborIntegerType)
-                {
-                    ret = cbor_value_get_int_checked(&map, &GA->pinProtocol);
-                    check_ret(ret);
-                }
-                else
-                {
-                    return CTAP2_ERR_INVALID_CBOR_TYPE;
-                }
-
+                ret = parse_int(&map, &GA->pinProtocol);
+                check_retr(ret);
                 break;
 
+            default:
+                ret = cbor_value_advance(&map);
+                check_ret(ret);
+
         }
         if (ret != 0)
         {
             printf2(TAG_ERR,"error, parsing failed\n");
             return ret;
         }
-
-        cbor_value_advance(&map);
-        check_ret(ret);
     }
 
 
@@ -1136,30 +1228,13 @@ uint8_t parse_cose_key(CborValue * it, COSE_key * cose)
         {
             case COSE_KEY_LABEL_KTY:
                 printf1(TAG_PARSE,"COSE_KEY_LABEL_KTY\n");
-                if (cbor_value_get_type(&map) == CborIntegerType)
-                {
-                    ret = cbor_value_get_int_checked(&map, &cose->kty);
-                    check_ret(ret);
-                }
-                else
-                {
-                    return CTAP2_ERR_INVALID_CBOR_TYPE;
-                }
-                break;
-            case COSE_KEY_LABEL_ALG:
-                printf1(TAG_PARSE,"COSE_KEY_LABEL_ALG\n");
+                ret = parse_int(&map, &cose->kty);
+                check_retr(ret);
                 break;
             case COSE_KEY_LABEL_CRV:
                 printf1(TAG_PARSE,"COSE_KEY_LABEL_CRV\n");
-                if (cbor_value_get_type(&map) == CborIntegerType)
-                {
-                    ret = cbor_value_get_int_checked(&map, &cose->crv);
-                    check_ret(ret);
-                }
-                else
-                {
-                    return CTAP2_ERR_INVALID_CBOR_TYPE;
-                }
+                ret = parse_int(&map, &cose->crv);
+                check_retr(ret);
                 break;
             case COSE_KEY_LABEL_X:
                 printf1(TAG_PARSE,"COSE_KEY_LABEL_X\n");
@@ -1174,18 +1249,26 @@ uint8_t parse_cose_key(CborValue * it, COSE_key * cose)
                 check_retr(ret);
                 ykey = 1;
 
+                break;
+            case COSE_KEY_LABEL_ALG:
+                printf1(TAG_PARSE,"COSE_KEY_LABEL_ALG\n");
+                ret = cbor_value_advance(&map);
+                check_ret(ret);
                 break;
             default:
                 printf1(TAG_PARSE,"Warning, unrecognized cose key option %d\n", key);
+                ret = cbor_value_advance(&map);
+                check_ret(ret);
         }
-
-        ret = cbor_value_advance(&map);
-        check_ret(ret);
     }
     if (xkey == 0 || ykey == 0 || cose->kty == 0 || cose->crv == 0)
     {
         return CTAP2_ERR_MISSING_PARAMETER;
     }
+
+    ret = cbor_value_leave_container(it, &map);
+    check_ret(ret);
+
     return 0;
 }
 
@@ -1237,28 +1320,13 @@ uint8_t ctap_parse_client_pin(CTAP_clientPin * CP, uint8_t * request, int length
         {
             case CP_pinProtocol:
                 printf1(TAG_CP,"CP_pinProtocol\n");
-                if (cbor_value_get_type(&map) == CborIntegerType)
-                {
-                    cbor_value_get_int_checked(&map, &CP->pinProtocol);
-                    check_ret(ret);
-                }
-                else
-                {
-                    return CTAP2_ERR_INVALID_CBOR_TYPE;
-                }
+                ret = parse_int(&map, &CP->pinProtocol);
+                check_retr(ret);
                 break;
             case CP_subCommand:
                 printf1(TAG_CP,"CP_subCommand\n");
-                if (cbor_value_get_type(&map) == CborIntegerType)
-                {
-                    cbor_value_get_int_checked(&map, &CP->subCommand);
-                    check_ret(ret);
-                }
-                else
-                {
-                    return CTAP2_ERR_INVALID_CBOR_TYPE;
-                }
-
+                ret = parse_int(&map, &CP->subCommand);
+                check_retr(ret);
                 break;
             case CP_keyAgreement:
                 printf1(TAG_CP,"CP_keyAgreement\n");
@@ -1288,6 +1356,8 @@ uint8_t ctap_parse_client_pin(CTAP_clientPin * CP, uint8_t * request, int length
                     sz = NEW_PIN_ENC_MAX_SIZE;
                     ret = cbor_value_copy_byte_string(&map, CP->newPinEnc, &sz, NULL);
                     check_ret(ret);
+                    ret = cbor_value_advance(&map);
+                    check_ret(ret);
                 }
                 else
                 {
@@ -1307,19 +1377,22 @@ uint8_t ctap_parse_client_pin(CTAP_clientPin * CP, uint8_t * request, int length
                 printf1(TAG_CP,"CP_getKeyAgreement\n");
                 ret = cbor_value_get_boolean(&map, &CP->getKeyAgreement);
                 check_ret(ret);
+                ret = cbor_value_advance(&map);
+                check_ret(ret);
                 break;
             case CP_getRetries:
                 printf1(TAG_CP,"CP_getRetries\n");
                 ret = cbor_value_get_boolean(&map, &CP->getRetries);
                 check_ret(ret);
+                ret = cbor_value_advance(&map);
+                check_ret(ret);
                 break;
             default:
                 printf1(TAG_CP,"Unknown key %d\n", key);
+                ret = cbor_value_advance(&map);
+                check_ret(ret);
         }
 
-        ret = cbor_value_advance(&map);
-        check_ret(ret);
-
     }
 
 
@@ -20,7 +20,7 @@ extern void _check_ret(CborError ret, int line, const char * filename);
 
 const char * cbor_value_get_type_string(const CborValue *value);
 
-
+// Each parse_* consumes its value, leaving @val on the item after it
 uint8_t parse_user(CTAP_makeCredential * MC, CborValue * val);
 uint8_t parse_pub_key_cred_param(CborValue * val, uint8_t * cred_type, int32_t * alg_type);
 uint8_t parse_pub_key_cred_params(CTAP_makeCredential * MC, CborValue * val);
@@ -36,7 +36,7 @@ uint8_t parse_cose_key(CborValue * it, COSE_key * cose);
 uint8_t ctap_parse_make_credential(CTAP_makeCredential * MC, CborEncoder * encoder, uint8_t * request, int length);
 uint8_t ctap_parse_get_assertion(CTAP_getAssertion * GA, uint8_t * request, int length);
 uint8_t ctap_parse_client_pin(CTAP_clientPin * CP, uint8_t * request, int length);
-uint8_t parse_credential_descriptor(CborValue * arr, CTAP_credentialDescriptor * cred);
+uint8_t parse_credential_descriptor(CborValue * arr, CTAP_credentialView * cred);
 
 
 #endif
@@ -54,29 +54,89 @@ typedef struct
 struct CID
 {
     uint32_t cid;
-    uint64_t last_used;
+    uint32_t last_used;
     uint8_t busy;
     uint8_t last_cmd;
 };
 
+// Maximum number of channels tracked at once.  When the table is full, the
+// channel that has been idle the longest is forgotten to make room.
+#ifndef CTAPHID_MAX_CIDS
+#define CTAPHID_MAX_CIDS            10
+#endif
+
+// Size of the hash index over the channel table.  Must be a power of 2
+// and larger than CTAPHID_MAX_CIDS; 2x keeps the probe sequences short.
+#ifndef CTAPHID_CID_INDEX_SIZE
+#define CTAPHID_CID_INDEX_SIZE      32
+#endif
+
+// Busy channels time out after this many ms without a packet.
+#define CTAPHID_CID_TIMEOUT         750
+
+// Timeouts are tracked on a timer wheel of CTAPHID_TIMER_WHEEL_SIZE buckets,
+// each (1 << CTAPHID_TIMER_TICK_SHIFT) ms wide, so a timeout may fire up to
+// one tick late.  The wheel must span more than the timeout so a channel
+// never lands in the bucket being expired.
+#define CTAPHID_TIMER_TICK_SHIFT    5
+#define CTAPHID_TIMER_WHEEL_SIZE    32
+
+#if (CTAPHID_CID_INDEX_SIZE & (CTAPHID_CID_INDEX_SIZE - 1)) || CTAPHID_CID_INDEX_SIZE <= CTAPHID_MAX_CIDS
+#error "CTAPHID_CID_INDEX_SIZE must be a power of 2 larger than CTAPHID_MAX_CIDS"
+#endif
+#if (CTAPHID_TIMER_WHEEL_SIZE << CTAPHID_TIMER_TICK_SHIFT) <= (CTAPHID_CID_TIMEOUT + (1 << CTAPHID_TIMER_TICK_SHIFT))
+#error "CTAPHID timer wheel is too short for CTAPHID_CID_TIMEOUT"
+#endif
+#if (CTAPHID_MAX_CIDS + CTAPHID_TIMER_WHEEL_SIZE + 2) > 0xffff
+#error "CTAPHID_MAX_CIDS is too large"
+#endif
+
+// Every channel is linked into exactly one circular list: a timer wheel
+// bucket while busy, the idle list (oldest first) or the free list.
+// The list heads are sentinel nodes placed after the channel entries.
+#define CID_LIST_WHEEL(b)           (CTAPHID_MAX_CIDS + (b))
+#define CID_LIST_IDLE               (CTAPHID_MAX_CIDS + CTAPHID_TIMER_WHEEL_SIZE)
+#define CID_LIST_FREE               (CTAPHID_MAX_CIDS + CTAPHID_TIMER_WHEEL_SIZE + 1)
+#define CID_LIST_NODES              (CTAPHID_MAX_CIDS + CTAPHID_TIMER_WHEEL_SIZE + 2)
 
 #define SUCESS          0
 #define SEQUENCE_ERROR  1
 
-static int state;
-static struct CID CIDS[10];
-#define CID_MAX (sizeof(CIDS)/sizeof(struct CID))
+// Number of channels that can reassemble a message at the same time.
+// Each one costs CTAPHID_BUFFER_SIZE bytes of RAM.
+#ifndef CTAPHID_BUFFER_POOL_SIZE
+#define CTAPHID_BUFFER_POOL_SIZE    1
+#endif
 
-static uint64_t active_cid_timestamp;
+typedef struct
+{
+    uint32_t cid;
+    int cmd;
+    uint16_t bcnt;
+    int offset;
+    int seq;
+    uint32_t ticket;        // order in which the message finished buffering
+    uint8_t buf[CTAPHID_BUFFER_SIZE];
+} CTAPHID_CHANNEL_BUFFER;
+
+static AUTHENTICATOR_LOCAL int state;
+static AUTHENTICATOR_LOCAL struct CID CIDS[CTAPHID_MAX_CIDS];
+static AUTHENTICATOR_LOCAL uint16_t cid_index[CTAPHID_CID_INDEX_SIZE];     // entry + 1, 0 if empty
+static AUTHENTICATOR_LOCAL uint16_t cid_next[CID_LIST_NODES];
+static AUTHENTICATOR_LOCAL uint16_t cid_prev[CID_LIST_NODES];
+static AUTHENTICATOR_LOCAL uint32_t cid_wheel_tick;
+
+static AUTHENTICATOR_LOCAL uint64_t active_cid_timestamp;
 
-static uint8_t ctap_buffer[CTAPHID_BUFFER_SIZE];
-static uint32_t ctap_buffer_cid;
-static int ctap_buffer_cmd;
-static uint16_t ctap_buffer_bcnt;
-static int ctap_buffer_offset;
-static int ctap_packet_seq;
+static AUTHENTICATOR_LOCAL CTAPHID_CHANNEL_BUFFER ctap_buffers[CTAPHID_BUFFER_POOL_SIZE];
+static AUTHENTICATOR_LOCAL uint32_t ctap_buffer_ticket;
 
-static void buffer_reset();
+// Buffer of the request currently being processed, NULL if none.
+static AUTHENTICATOR_LOCAL CTAPHID_CHANNEL_BUFFER * active_buffer;
+static AUTHENTICATOR_LOCAL uint8_t is_busy;
+
+static void buffer_reset(CTAPHID_CHANNEL_BUFFER * cb);
+static void cid_table_init();
 
 #define CTAPHID_WRITE_INIT      0x01
 #define CTAPHID_WRITE_FLUSH     0x02
@@ -87,14 +147,21 @@ static void ctaphid_write(CTAPHID_WRITE_BUFFER * wb, void * _data, int len);
 
 void ctaphid_init()
 {
+    int i;
     state = IDLE;
-    buffer_reset();
+    cid_table_init();
+    for (i = 0; i < CTAPHID_BUFFER_POOL_SIZE; i++)
+    {
+        buffer_reset(ctap_buffers + i);
+    }
+    active_buffer = NULL;
+    is_busy = 0;
     //ctap_reset_state();
 }
 
 static uint32_t get_new_cid()
 {
-    static uint32_t cid = 1;
+    static AUTHENTICATOR_LOCAL uint32_t cid = 1;
     do
     {
         cid++;
@@ -102,62 +169,158 @@ static uint32_t get_new_cid()
     return cid;
 }
 
-static int8_t add_cid(uint32_t cid)
+static void cid_list_remove(uint16_t n)
 {
-    uint32_t i;
-    for(i = 0; i < CID_MAX-1; i++)
+    cid_next[cid_prev[n]] = cid_next[n];
+    cid_prev[cid_next[n]] = cid_prev[n];
+}
+
+// Append n to the tail of list head
+static void cid_list_append(uint16_t head, uint16_t n)
+{
+    cid_prev[n] = cid_prev[head];
+    cid_next[n] = head;
+    cid_next[cid_prev[head]] = n;
+    cid_prev[head] = n;
+}
+
+static void cid_list_move(uint16_t head, uint16_t n)
+{
+    cid_list_remove(n);
+    cid_list_append(head, n);
+}
+
+static uint32_t cid_hash(uint32_t cid)
+{
+    return ((cid * 0x9e3779b1UL) >> 16) & (CTAPHID_CID_INDEX_SIZE - 1);
+}
+
+// Return index slot of cid, or -1 if it is not in the table
+static int32_t cid_find(uint32_t cid)
+{
+    uint32_t i = cid_hash(cid);
+    while (cid_index[i])
     {
-        if (!CIDS[i].busy)
+        if (CIDS[cid_index[i] - 1].cid == cid)
         {
-            CIDS[i].cid = cid;
-            CIDS[i].busy = 1;
-            CIDS[i].last_used = millis();
-            return 0;
+            return i;
         }
+        i = (i + 1) & (CTAPHID_CID_INDEX_SIZE - 1);
     }
     return -1;
 }
 
-static int8_t cid_exists(uint32_t cid)
+// Remove an entry from the linear probing index, shifting back the
+// entries after it so that lookups never need tombstones.
+static void cid_index_remove(uint32_t i)
 {
-    uint32_t i;
-    for(i = 0; i < CID_MAX-1; i++)
+    uint32_t j = i;
+    uint32_t k;
+    cid_index[i] = 0;
+    while (1)
     {
-        if (CIDS[i].cid == cid)
+        j = (j + 1) & (CTAPHID_CID_INDEX_SIZE - 1);
+        if (!cid_index[j])
+        {
+            return;
+        }
+        k = cid_hash(CIDS[cid_index[j] - 1].cid);
+        // Leave entries whose home slot is cyclically in (i, j]
+        if ((i < j) ? (i < k && k <= j) : (i < k || k <= j))
         {
-            return 1;
+            continue;
         }
+        cid_index[i] = cid_index[j];
+        cid_index[j] = 0;
+        i = j;
     }
+}
+
+// Mark entry n busy and schedule its timeout
+static void cid_arm(uint16_t n)
+{
+    uint32_t expires;
+    CIDS[n].busy = 1;
+    CIDS[n].last_used = millis();
+    expires = (CIDS[n].last_used + CTAPHID_CID_TIMEOUT + (1 << CTAPHID_TIMER_TICK_SHIFT) - 1) >> CTAPHID_TIMER_TICK_SHIFT;
+    cid_list_move(CID_LIST_WHEEL(expires & (CTAPHID_TIMER_WHEEL_SIZE - 1)), n);
+}
+
+static void cid_table_init()
+{
+    uint16_t i;
+    memset(CIDS, 0, sizeof(CIDS));
+    memset(cid_index, 0, sizeof(cid_index));
+    for (i = CTAPHID_MAX_CIDS; i < CID_LIST_NODES; i++)
+    {
+        cid_next[i] = i;
+        cid_prev[i] = i;
+    }
+    for (i = 0; i < CTAPHID_MAX_CIDS; i++)
+    {
+        cid_list_append(CID_LIST_FREE, i);
+    }
+    cid_wheel_tick = millis() >> CTAPHID_TIMER_TICK_SHIFT;
+}
+
+static int8_t add_cid(uint32_t cid)
+{
+    uint16_t n;
+    uint32_t i;
+    if (cid_next[CID_LIST_FREE] != CID_LIST_FREE)
+    {
+        n = cid_next[CID_LIST_FREE];
+    }
+    else if (cid_next[CID_LIST_IDLE] != CID_LIST_IDLE)
+    {
+        n = cid_next[CID_LIST_IDLE];
+        cid_index_remove(cid_find(CIDS[n].cid));
+    }
+    else
+    {
+        return -1;
+    }
+
+    CIDS[n].cid = cid;
+    CIDS[n].last_cmd = 0;
+    i = cid_hash(cid);
+    while (cid_index[i])
+    {
+        i = (i + 1) & (CTAPHID_CID_INDEX_SIZE - 1);
+    }
+    cid_index[i] = n + 1;
+    cid_arm(n);
     return 0;
 }
 
+static int8_t cid_exists(uint32_t cid)
+{
+    return cid_find(cid) != -1;
+}
+
 static int8_t cid_refresh(uint32_t cid)
 {
-    uint32_t i;
-    for(i = 0; i < CID_MAX-1; i++)
+    int32_t i = cid_find(cid);
+    if (i == -1)
     {
-        if (CIDS[i].cid == cid)
-        {
-            CIDS[i].last_used = millis();
-            CIDS[i].busy = 1;
-            return 0;
-        }
+        return -1;
     }
-    return -1;
+    cid_arm(cid_index[i] - 1);
+    return 0;
 }
 
 static int8_t cid_del(uint32_t cid)
 {
-    uint32_t i;
-    for(i = 0; i < CID_MAX-1; i++)
+    int32_t i = cid_find(cid);
+    uint16_t n;
+    if (i == -1)
     {
-        if (CIDS[i].cid == cid)
-        {
-            CIDS[i].busy = 0;
-            return 0;
-        }
+        return -1;
     }
-    return -1;
+    n = cid_index[i] - 1;
+    CIDS[n].busy = 0;
+    cid_list_move(CID_LIST_IDLE, n);
+    return 0;
 }
 
 static int is_broadcast(CTAPHID_PACKET * pkt)
@@ -170,30 +333,35 @@ static int is_init_pkt(CTAPHID_PACKET * pkt)
     return (pkt->pkt.init.cmd == CTAPHID_INIT);
 }
 
+static int is_cancel_pkt(CTAPHID_PACKET * pkt)
+{
+    return (pkt->pkt.init.cmd == CTAPHID_CANCEL);
+}
+
 static int is_cont_pkt(CTAPHID_PACKET * pkt)
 {
     return !(pkt->pkt.init.cmd & TYPE_INIT);
 }
 
 
-static int buffer_packet(CTAPHID_PACKET * pkt)
+static int buffer_packet(CTAPHID_CHANNEL_BUFFER * cb, CTAPHID_PACKET * pkt)
 {
     if (pkt->pkt.init.cmd & TYPE_INIT)
     {
-        ctap_buffer_bcnt = ctaphid_packet_len(pkt);
-        int pkt_len = (ctap_buffer_bcnt < CTAPHID_INIT_PAYLOAD_SIZE) ? ctap_buffer_bcnt : CTAPHID_INIT_PAYLOAD_SIZE;
-        ctap_buffer_cmd = pkt->pkt.init.cmd;
-        ctap_buffer_cid = pkt->cid;
-        ctap_buffer_offset = pkt_len;
-        ctap_packet_seq = -1;
-        memmove(ctap_buffer, pkt->pkt.init.payload, pkt_len);
+        cb->bcnt = ctaphid_packet_len(pkt);
+        int pkt_len = (cb->bcnt < CTAPHID_INIT_PAYLOAD_SIZE) ? cb->bcnt : CTAPHID_INIT_PAYLOAD_SIZE;
+        cb->cmd = pkt->pkt.init.cmd;
+        cb->cid = pkt->cid;
+        cb->offset = pkt_len;
+        cb->seq = -1;
+        memmove(cb->buf, pkt->pkt.init.payload, pkt_len);
     }
     else
     {
-        int leftover = ctap_buffer_bcnt - ctap_buffer_offset;
+        int leftover = cb->bcnt - cb->offset;
         int diff = leftover - CTAPHID_CONT_PAYLOAD_SIZE;
-        ctap_packet_seq++;
-        if (ctap_packet_seq != pkt->pkt.cont.seq)
+        cb->seq++;
+        if (cb->seq != pkt->pkt.cont.seq)
         {
             return SEQUENCE_ERROR;
         }
@@ -201,33 +369,38 @@ static int buffer_packet(CTAPHID_PACKET * pkt)
         if (diff <= 0)
         {
             // only move the leftover amount
-            memmove(ctap_buffer + ctap_buffer_offset, pkt->pkt.cont.payload, leftover);
-            ctap_buffer_offset += leftover;
+            memmove(cb->buf + cb->offset, pkt->pkt.cont.payload, leftover);
+            cb->offset += leftover;
         }
         else
         {
-            memmove(ctap_buffer + ctap_buffer_offset, pkt->pkt.cont.payload, CTAPHID_CONT_PAYLOAD_SIZE);
-            ctap_buffer_offset += CTAPHID_CONT_PAYLOAD_SIZE;
+            memmove(cb->buf + cb->offset, pkt->pkt.cont.payload, CTAPHID_CONT_PAYLOAD_SIZE);
+            cb->offset += CTAPHID_CONT_PAYLOAD_SIZE;
         }
     }
+
+    if (cb->offset == cb->bcnt)
+    {
+        cb->ticket = ctap_buffer_ticket++;
+    }
     return SUCESS;
 }
 
-static void buffer_reset()
+static void buffer_reset(CTAPHID_CHANNEL_BUFFER * cb)
 {
-    ctap_buffer_bcnt = 0;
-    ctap_buffer_offset = 0;
-    ctap_packet_seq = 0;
-    ctap_buffer_cid = 0;
+    cb->bcnt = 0;
+    cb->offset = 0;
+    cb->seq = 0;
+    cb->cid = 0;
 }
 
-static int buffer_status()
+static int buffer_status(CTAPHID_CHANNEL_BUFFER * cb)
 {
-    if (ctap_buffer_bcnt == 0)
+    if (cb->cid == 0)
     {
         return EMPTY;
     }
-    else if (ctap_buffer_offset == ctap_buffer_bcnt)
+    else if (cb->offset == cb->bcnt)
     {
         return BUFFERED;
     }
@@ -237,20 +410,52 @@ static int buffer_status()
     }
 }
 
-static int buffer_cmd()
+// Return the buffer holding a message from @cid, or NULL.
+static CTAPHID_CHANNEL_BUFFER * buffer_get(uint32_t cid)
 {
-    return ctap_buffer_cmd;
+    int i;
+    for (i = 0; i < CTAPHID_BUFFER_POOL_SIZE; i++)
+    {
+        if (ctap_buffers[i].cid == cid && buffer_status(ctap_buffers + i) != EMPTY)
+        {
+            return ctap_buffers + i;
+        }
+    }
+    return NULL;
 }
 
-static uint32_t buffer_cid()
+static CTAPHID_CHANNEL_BUFFER * buffer_alloc()
 {
-    return ctap_buffer_cid;
+    int i;
+    for (i = 0; i < CTAPHID_BUFFER_POOL_SIZE; i++)
+    {
+        if (buffer_status(ctap_buffers + i) == EMPTY)
+        {
+            return ctap_buffers + i;
+        }
+    }
+    return NULL;
 }
 
-
-static int buffer_len()
+// Return the fully buffered message that finished first and isn't
+// already being processed, or NULL.
+static CTAPHID_CHANNEL_BUFFER * buffer_next_ready()
 {
-    return ctap_buffer_bcnt;
+    CTAPHID_CHANNEL_BUFFER * next = NULL;
+    int i;
+    for (i = 0; i < CTAPHID_BUFFER_POOL_SIZE; i++)
+    {
+        CTAPHID_CHANNEL_BUFFER * cb = ctap_buffers + i;
+        if (cb == active_buffer || buffer_status(cb) != BUFFERED)
+        {
+            continue;
+        }
+        if (next == NULL || (int32_t)(cb->ticket - next->ticket) < 0)
+        {
+            next = cb;
+        }
+    }
+    return next;
 }
 
 // Buffer data and send in HID_MESSAGE_SIZE chunks
@@ -347,22 +552,64 @@ static void send_init_response(uint32_t oldcid, uint32_t newcid, uint8_t * nonce
 
 void ctaphid_check_timeouts()
 {
-    uint8_t i;
-    for(i = 0; i < CID_MAX; i++)
+    uint32_t now = millis();
+    uint32_t now_tick = now >> CTAPHID_TIMER_TICK_SHIFT;
+    uint32_t ticks = now_tick - cid_wheel_tick;
+    uint16_t head, n, next;
+    CTAPHID_CHANNEL_BUFFER * cb;
+
+    if (ticks > CTAPHID_TIMER_WHEEL_SIZE)
     {
-        if (CIDS[i].busy && ((millis() - CIDS[i].last_used) >= 750))
+        ticks = CTAPHID_TIMER_WHEEL_SIZE;
+    }
+    while (ticks--)
+    {
+        cid_wheel_tick++;
+        head = CID_LIST_WHEEL(cid_wheel_tick & (CTAPHID_TIMER_WHEEL_SIZE - 1));
+        for (n = cid_next[head]; n != head; n = next)
         {
-            printf1(TAG_HID, "TIMEOUT CID: %08x\n", CIDS[i].cid);
-            ctaphid_send_error(CIDS[i].cid, CTAP1_ERR_TIMEOUT);
-            CIDS[i].busy = 0;
-            if (CIDS[i].cid == buffer_cid())
+            next = cid_next[n];
+            if ((now - CIDS[n].last_used) < CTAPHID_CID_TIMEOUT)
+            {
+                continue;
+            }
+            printf1(TAG_HID, "TIMEOUT CID: %08x\n", CIDS[n].cid);
+            ctaphid_send_error(CIDS[n].cid, CTAP1_ERR_TIMEOUT);
+            CIDS[n].busy = 0;
+            cid_list_move(CID_LIST_IDLE, n);
+            cb = buffer_get(CIDS[n].cid);
+            if (cb != NULL && cb != active_buffer)
             {
-                buffer_reset();
+                buffer_reset(cb);
             }
-            // memset(CIDS + i, 0, sizeof(struct CID));
         }
     }
+    cid_wheel_tick = now_tick;
+}
+
+int32_t ctaphid_next_timeout()
+{
+    uint32_t now = millis();
+    uint32_t tick;
+    uint32_t i;
+    uint16_t head;
 
+    for (i = 1; i <= CTAPHID_TIMER_WHEEL_SIZE; i++)
+    {
+        tick = cid_wheel_tick + i;
+        head = CID_LIST_WHEEL(tick & (CTAPHID_TIMER_WHEEL_SIZE - 1));
+        if (cid_next[head] != head)
+        {
+            tick <<= CTAPHID_TIMER_TICK_SHIFT;
+            return ((int32_t)(tick - now) > 0) ? (int32_t)(tick - now) : 0;
+        }
+    }
+    return -1;
+}
+
+uint32_t ctaphid_active_cid()
+{
+    return (active_buffer != NULL) ? active_buffer->cid : 0;
 }
 
 void ctaphid_update_status(int8_t status)
@@ -371,7 +618,7 @@ void ctaphid_update_status(int8_t status)
     printf1(TAG_HID, "Send device update %d!\n",status);
     ctaphid_write_buffer_init(&wb);
 
-    wb.cid = buffer_cid();
+    wb.cid = ctaphid_active_cid();
     wb.cmd = CTAPHID_KEEPALIVE;
     wb.bcnt = 1;
 
@@ -391,6 +638,7 @@ static int ctaphid_buffer_packet(uint8_t * pkt_raw, uint8_t * cmd, uint32_t * ci
     int ret;
     uint32_t oldcid;
     uint32_t newcid;
+    CTAPHID_CHANNEL_BUFFER * cb;
 
 
     *cid = pkt->cid;
@@ -410,7 +658,13 @@ static int ctaphid_buffer_packet(uint8_t * pkt_raw, uint8_t * cmd, uint32_t * ci
             return HID_ERROR;
         }
 
-        ctaphid_init();
+        // INIT aborts any message still being reassembled on this channel
+        cb = buffer_get(pkt->cid);
+        if (cb != NULL && cb != active_buffer)
+        {
+            buffer_reset(cb);
+        }
+
         if (is_broadcast(pkt))
         {
             // Check if any existing cids are busy first ?
@@ -449,9 +703,11 @@ static int ctaphid_buffer_packet(uint8_t * pkt_raw, uint8_t * cmd, uint32_t * ci
             return HID_ERROR;
         }
 
+        cb = buffer_get(pkt->cid);
+
         if (! cid_exists(pkt->cid) && ! is_cont_pkt(pkt))
         {
-            if (buffer_status() == EMPTY)
+            if (cb != NULL || buffer_alloc() != NULL)
             {
                 add_cid(pkt->cid);
             }
@@ -459,30 +715,24 @@ static int ctaphid_buffer_packet(uint8_t * pkt_raw, uint8_t * cmd, uint32_t * ci
 
         if (cid_exists(pkt->cid))
         {
-            if (buffer_status() == BUFFERING)
+            if (cb != NULL && buffer_status(cb) == BUFFERING && ! is_cont_pkt(pkt))
             {
-                if (pkt->cid == buffer_cid() && ! is_cont_pkt(pkt))
-                {
-                    printf2(TAG_ERR,"INVALID_SEQ\n");
-                    printf2(TAG_ERR,"Have %d/%d bytes\n", ctap_buffer_offset, ctap_buffer_bcnt);
-                    *cmd = CTAP1_ERR_INVALID_SEQ;
-                    return HID_ERROR;
-                }
-                else if (pkt->cid != buffer_cid())
-                {
-                    if (! is_cont_pkt(pkt))
-                    {
-                        printf2(TAG_ERR,"BUSY with %08x\n", buffer_cid());
-                        *cmd = CTAP1_ERR_CHANNEL_BUSY;
-                        return HID_ERROR;
-                    }
-                    else
-                    {
-                        printf2(TAG_ERR,"ignoring random cont packet from %04x\n",pkt->cid);
-                        return HID_IGNORE;
-                    }
-                }
+                printf2(TAG_ERR,"INVALID_SEQ\n");
+                printf2(TAG_ERR,"Have %d/%d bytes\n", cb->offset, cb->bcnt);
+                *cmd = CTAP1_ERR_INVALID_SEQ;
+                return HID_ERROR;
             }
+
+            if (is_cancel_pkt(pkt))
+            {
+                // CANCEL has no payload and has to get through while the
+                // request on this channel is still being processed.
+                cid_refresh(pkt->cid);
+                *cmd = CTAPHID_CANCEL;
+                *len = 0;
+                return BUFFERED;
+            }
+
             if (! is_cont_pkt(pkt))
             {
 
@@ -491,17 +741,30 @@ static int ctaphid_buffer_packet(uint8_t * pkt_raw, uint8_t * cmd, uint32_t * ci
                     *cmd = CTAP1_ERR_INVALID_LENGTH;
                     return HID_ERROR;
                 }
+                if (cb != NULL)
+                {
+                    printf2(TAG_ERR,"BUSY, %08x already has a pending message\n", pkt->cid);
+                    *cmd = CTAP1_ERR_CHANNEL_BUSY;
+                    return HID_ERROR;
+                }
+                cb = buffer_alloc();
+                if (cb == NULL)
+                {
+                    printf2(TAG_ERR,"BUSY, no free buffer for %08x\n", pkt->cid);
+                    *cmd = CTAP1_ERR_CHANNEL_BUSY;
+                    return HID_ERROR;
+                }
             }
             else
             {
-                if (buffer_status() == EMPTY || pkt->cid != buffer_cid())
+                if (cb == NULL || buffer_status(cb) != BUFFERING)
                 {
                     printf2(TAG_ERR,"ignoring random cont packet from %04x\n",pkt->cid);
                     return HID_IGNORE;
                 }
             }
 
-            if (buffer_packet(pkt) == SEQUENCE_ERROR)
+            if (buffer_packet(cb, pkt) == SEQUENCE_ERROR)
             {
                 printf2(TAG_ERR,"Buffering sequence error\n");
                 *cmd = CTAP1_ERR_INVALID_SEQ;
@@ -529,52 +792,28 @@ static int ctaphid_buffer_packet(uint8_t * pkt_raw, uint8_t * cmd, uint32_t * ci
         }
     }
 
-    *len = buffer_len();
-    *cmd = buffer_cmd();
-    return buffer_status();
+    *len = cb->bcnt;
+    *cmd = cb->cmd;
+    return buffer_status(cb);
 }
 
 extern void _check_ret(CborError ret, int line, const char * filename);
 #define check_hardcore(r)   _check_ret(r,__LINE__, __FILE__);\
                             if ((r) != CborNoError) exit(1);
 
-uint8_t ctaphid_handle_packet(uint8_t * pkt_raw)
+static uint8_t ctaphid_dispatch(CTAPHID_CHANNEL_BUFFER * cb)
 {
-    uint8_t cmd;
-    uint32_t cid;
-    int len;
+    uint8_t cmd = cb->cmd;
+    uint32_t cid = cb->cid;
+    int len = cb->bcnt;
 #ifndef DISABLE_CTAPHID_CBOR
     int status;
 #endif
 
-    static uint8_t is_busy = 0;
-    static CTAPHID_WRITE_BUFFER wb;
+    static AUTHENTICATOR_LOCAL CTAPHID_WRITE_BUFFER wb;
     CTAP_RESPONSE ctap_resp;
 
-    int bufstatus = ctaphid_buffer_packet(pkt_raw, &cmd, &cid, &len);
-
-    if (bufstatus == HID_IGNORE)
-    {
-        return 0;
-    }
-
-    if (bufstatus == HID_ERROR)
-    {
-        cid_del(cid);
-        if (cmd == CTAP1_ERR_INVALID_SEQ)
-        {
-            buffer_reset();
-        }
-        ctaphid_send_error(cid, cmd);
-        return 0;
-    }
-
-    if (bufstatus == BUFFERING)
-    {
-        active_cid_timestamp = millis();
-        return 0;
-    }
-
+    active_buffer = cb;
 
     switch(cmd)
     {
@@ -592,7 +831,7 @@ uint8_t ctaphid_handle_packet(uint8_t * pkt_raw)
             wb.cmd = CTAPHID_PING;
             wb.bcnt = len;
             timestamp();
-            ctaphid_write(&wb, ctap_buffer, len);
+            ctaphid_write(&wb, cb->buf, len);
             ctaphid_write(&wb, NULL,0);
             printf1(TAG_TIME,"PING writeback: %d ms\n",timestamp());
 
@@ -621,17 +860,17 @@ uint8_t ctaphid_handle_packet(uint8_t * pkt_raw)
             {
                 printf2(TAG_ERR,"Error,invalid 0 length field for cbor packet\n");
                 ctaphid_send_error(cid, CTAP1_ERR_INVALID_LENGTH);
-                return 0;
+                break;
             }
             if (is_busy)
             {
                 printf1(TAG_HID,"Channel busy for CBOR\n");
                 ctaphid_send_error(cid, CTAP1_ERR_CHANNEL_BUSY);
-                return 0;
+                break;
             }
             is_busy = 1;
             ctap_response_init(&ctap_resp);
-            status = ctap_request(ctap_buffer, len, &ctap_resp);
+            status = ctap_request(cb->buf, len, &ctap_resp);
 
             ctaphid_write_buffer_init(&wb);
             wb.cid = cid;
@@ -654,17 +893,17 @@ uint8_t ctaphid_handle_packet(uint8_t * pkt_raw)
             {
                 printf2(TAG_ERR,"Error,invalid 0 length field for MSG/U2F packet\n");
                 ctaphid_send_error(cid, CTAP1_ERR_INVALID_LENGTH);
-                return 0;
+                break;
             }
             if (is_busy)
             {
                 printf1(TAG_HID,"Channel busy for MSG\n");
                 ctaphid_send_error(cid, CTAP1_ERR_CHANNEL_BUSY);
-                return 0;
+                break;
             }
             is_busy = 1;
             ctap_response_init(&ctap_resp);
-            u2f_request((struct u2f_request_apdu*)ctap_buffer, &ctap_resp);
+            u2f_request((struct u2f_request_apdu*)cb->buf, &ctap_resp);
 
             ctaphid_write_buffer_init(&wb);
             wb.cid = cid;
@@ -675,16 +914,12 @@ uint8_t ctaphid_handle_packet(uint8_t * pkt_raw)
             ctaphid_write(&wb, NULL, 0);
             is_busy = 0;
             break;
-        case CTAPHID_CANCEL:
-            printf1(TAG_HID,"CTAPHID_CANCEL\n");
-            is_busy = 0;
-            break;
 #if defined(IS_BOOTLOADER)
         case CTAPHID_BOOT:
             printf1(TAG_HID,"CTAPHID_BOOT\n");
             ctap_response_init(&ctap_resp);
             u2f_set_writeback_buffer(&ctap_resp);
-            is_busy = bootloader_bridge(len, ctap_buffer);
+            is_busy = bootloader_bridge(len, cb->buf);
 
             ctaphid_write_buffer_init(&wb);
             wb.cid = cid;
@@ -719,12 +954,12 @@ uint8_t ctaphid_handle_packet(uint8_t * pkt_raw)
             ctaphid_write_buffer_init(&wb);
             wb.cid = cid;
             wb.cmd = CTAPHID_GETRNG;
-            wb.bcnt = ctap_buffer[0];
+            wb.bcnt = cb->buf[0];
             if (!wb.bcnt)
                 wb.bcnt = 57;
-            memset(ctap_buffer,0,wb.bcnt);
-            ctap_generate_rng(ctap_buffer, wb.bcnt);
-            ctaphid_write(&wb, &ctap_buffer, wb.bcnt);
+            memset(cb->buf,0,wb.bcnt);
+            ctap_generate_rng(cb->buf, wb.bcnt);
+            ctaphid_write(&wb, cb->buf, wb.bcnt);
             ctaphid_write(&wb, NULL, 0);
             is_busy = 0;
         break;
@@ -752,7 +987,7 @@ uint8_t ctaphid_handle_packet(uint8_t * pkt_raw)
             CborParser parser;
             CborValue it, map;
             ret = cbor_parser_init(
-                ctap_buffer, (size_t) buffer_len(),
+                cb->buf, (size_t) len,
                 // strictly speaking, CTAP is not RFC canonical...
                 CborValidateCanonicalFormat,
                 &parser, &it);
@@ -816,20 +1051,20 @@ uint8_t ctaphid_handle_packet(uint8_t * pkt_raw)
                 // calculate hash
                 crypto_sha256_init();
                 crypto_sha256_update(data, data_length);
-                crypto_sha256_final(ctap_buffer);
+                crypto_sha256_final(cb->buf);
                 // write output
                 wb.bcnt = CF_SHA256_HASHSZ;  // 32 bytes
-                ctaphid_write(&wb, &ctap_buffer, CF_SHA256_HASHSZ);
+                ctaphid_write(&wb, cb->buf, CF_SHA256_HASHSZ);
             }
 
             if (sha_version == 512) {
                 // calculate hash
                 crypto_sha512_init();
                 crypto_sha512_update(data, data_length);
-                crypto_sha512_final(ctap_buffer);
+                crypto_sha512_final(cb->buf);
                 // write output
                 wb.bcnt = CF_SHA512_HASHSZ;  // 64 bytes
-                ctaphid_write(&wb, &ctap_buffer, CF_SHA512_HASHSZ);
+                ctaphid_write(&wb, cb->buf, CF_SHA512_HASHSZ);
             }
 
             // finalize
@@ -850,10 +1085,10 @@ uint8_t ctaphid_handle_packet(uint8_t * pkt_raw)
             wb.bcnt = CF_SHA256_HASHSZ;  // 32 bytes
             // calculate hash
             crypto_sha256_init();
-            crypto_sha256_update(ctap_buffer, buffer_len());
-            crypto_sha256_final(ctap_buffer);
+            crypto_sha256_update(cb->buf, len);
+            crypto_sha256_final(cb->buf);
             // copy to output
-            ctaphid_write(&wb, &ctap_buffer, CF_SHA256_HASHSZ);
+            ctaphid_write(&wb, cb->buf, CF_SHA256_HASHSZ);
             ctaphid_write(&wb, NULL, 0);
             is_busy = 0;
         break;
@@ -869,25 +1104,98 @@ uint8_t ctaphid_handle_packet(uint8_t * pkt_raw)
             wb.bcnt = CF_SHA512_HASHSZ;  // 64 bytes
             // calculate hash
             crypto_sha512_init();
-            crypto_sha512_update(ctap_buffer, buffer_len());
-            crypto_sha512_final(ctap_buffer);
+            crypto_sha512_update(cb->buf, len);
+            crypto_sha512_final(cb->buf);
             // copy to output
-            ctaphid_write(&wb, &ctap_buffer, CF_SHA512_HASHSZ);
+            ctaphid_write(&wb, cb->buf, CF_SHA512_HASHSZ);
             ctaphid_write(&wb, NULL, 0);
             is_busy = 0;
         break;
         */
 #endif
         default:
-            printf2(TAG_ERR,"error, unimplemented HID cmd: %02x\r\n", buffer_cmd());
+            printf2(TAG_ERR,"error, unimplemented HID cmd: %02x\r\n", cmd);
             ctaphid_send_error(cid, CTAP1_ERR_INVALID_COMMAND);
             break;
     }
+    active_buffer = NULL;
     cid_del(cid);
-    buffer_reset();
+    buffer_reset(cb);
 
     printf1(TAG_HID,"\n");
     if (!is_busy) return cmd;
     else return 0;
 
 }
+
+uint8_t ctaphid_handle_packet(uint8_t * pkt_raw)
+{
+    uint8_t cmd = 0;
+    uint32_t cid;
+    int len = 0;
+    CTAPHID_CHANNEL_BUFFER * cb;
+
+    int bufstatus = ctaphid_buffer_packet(pkt_raw, &cmd, &cid, &len);
+
+    if (bufstatus == HID_IGNORE)
+    {
+        return 0;
+    }
+
+    if (bufstatus == HID_ERROR)
+    {
+        cb = buffer_get(cid);
+        if (cmd == CTAP1_ERR_INVALID_SEQ && cb != NULL && cb != active_buffer)
+        {
+            buffer_reset(cb);
+            cb = NULL;
+        }
+        if (cb == NULL)
+        {
+            cid_del(cid);
+        }
+        ctaphid_send_error(cid, cmd);
+        return 0;
+    }
+
+    if (bufstatus == BUFFERING)
+    {
+        active_cid_timestamp = millis();
+        return 0;
+    }
+
+    if (cmd == CTAPHID_CANCEL)
+    {
+        printf1(TAG_HID,"CTAPHID_CANCEL\n");
+        ctap_cancel_next_assertions(cid);
+        if (buffer_get(cid) == NULL)
+        {
+            cid_del(cid);
+        }
+        // Only the channel whose request is processing can cancel it
+        if (active_buffer == NULL || active_buffer->cid != cid)
+        {
+            printf1(TAG_HID,"ignoring cancel from %08x\n", cid);
+            return 0;
+        }
+        is_busy = 0;
+        return CTAPHID_CANCEL;
+    }
+
+    if (active_buffer != NULL)
+    {
+        // Re-entered while a request is processing (e.g. waiting on user presence).
+        // The message stays buffered and is handled once that request completes.
+        printf1(TAG_HID,"queueing message from %08x\n", cid);
+        return 0;
+    }
+
+    // Handle everything that is fully buffered, oldest first
+    cmd = 0;
+    while ((cb = buffer_next_ready()) != NULL)
+    {
+        cmd = ctaphid_dispatch(cb);
+    }
+
+    return cmd;
+}
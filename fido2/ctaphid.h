@@ -94,8 +94,15 @@ uint8_t ctaphid_handle_packet(uint8_t * pkt_raw);
 
 void ctaphid_check_timeouts();
 
+// Return ms until ctaphid_check_timeouts has a channel to expire,
+// or -1 if no channel is busy.
+int32_t ctaphid_next_timeout();
+
 void ctaphid_update_status(int8_t status);
 
+// @return channel of the request being processed, or 0 if there is none
+uint32_t ctaphid_active_cid();
+
 
 #define ctaphid_packet_len(pkt)     ((uint16_t)((pkt)->pkt.init.bcnth << 8) | ((pkt)->pkt.init.bcntl))
 
@@ -161,7 +161,7 @@ int8_t wallet_pin(uint8_t subcmd, uint8_t * pinAuth, uint8_t * arg1, uint8_t * a
 
 int16_t bridge_u2f_to_wallet(uint8_t * _chal, uint8_t * _appid, uint8_t klen, uint8_t * keyh)
 {
-    static uint8_t msg_buf[WALLET_MAX_BUFFER];
+    static AUTHENTICATOR_LOCAL uint8_t msg_buf[WALLET_MAX_BUFFER];
     int reqlen = klen;
     int i;
     int8_t ret = 0;
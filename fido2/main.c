@@ -71,6 +71,7 @@ int main()
         }
         else
         {
+            ctap_idle();
         }
         ctaphid_check_timeouts();
 
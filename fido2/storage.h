@@ -42,6 +42,6 @@ typedef struct
     uint32_t count;
 } AuthenticatorCounter;
 
-extern AuthenticatorState STATE;
+extern AUTHENTICATOR_LOCAL AuthenticatorState STATE;
 
 #endif
@@ -35,6 +35,16 @@ void ctaphid_check_timeouts()
 
 }
 
+int32_t ctaphid_next_timeout()
+{
+    return -1;
+}
+
+uint32_t ctaphid_active_cid()
+{
+    return 0;
+}
+
 #endif
 
 
@@ -49,6 +59,10 @@ void ctap_response_init(CTAP_RESPONSE * resp)
 {
 }
 
+void ctap_cancel_next_assertions(uint32_t cid)
+{
+}
+
 void u2f_request(struct u2f_request_apdu* req, CTAP_RESPONSE * resp)
 {
     printf1(TAG_GEN,"STUB: u2f_request\n");
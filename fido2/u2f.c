@@ -26,7 +26,7 @@ int8_t u2f_response_writeback(const uint8_t * buf, uint16_t len);
 void u2f_reset_response();
 
 
-static CTAP_RESPONSE * _u2f_resp = NULL;
+static AUTHENTICATOR_LOCAL CTAP_RESPONSE * _u2f_resp = NULL;
 
 void u2f_request_ex(APDU_HEADER *req, uint8_t *payload, uint32_t len, CTAP_RESPONSE * resp)
 {
@@ -166,10 +166,11 @@ static int8_t u2f_load_key(struct u2f_key_handle * kh, uint8_t * appid)
 static void u2f_make_auth_tag(struct u2f_key_handle * kh, uint8_t * appid, uint8_t * tag)
 {
     uint8_t hashbuf[32];
-    crypto_sha256_hmac_init(CRYPTO_MASTER_KEY, 0, hashbuf);
-    crypto_sha256_update(kh->key, U2F_KEY_HANDLE_KEY_SIZE);
-    crypto_sha256_update(appid, U2F_APPLICATION_SIZE);
-    crypto_sha256_hmac_final(CRYPTO_MASTER_KEY, 0,hashbuf);
+    SHA256_CTX ctx;
+    crypto_hmac_ctx_init(&ctx, CRYPTO_MASTER_KEY, 0);
+    crypto_sha256_ctx_update(&ctx, kh->key, U2F_KEY_HANDLE_KEY_SIZE);
+    crypto_sha256_ctx_update(&ctx, appid, U2F_APPLICATION_SIZE);
+    crypto_hmac_ctx_final(&ctx, CRYPTO_MASTER_KEY, 0, hashbuf);
     memmove(tag, hashbuf, CREDENTIAL_TAG_SIZE);
 }
 
@@ -12,12 +12,26 @@
 
 #define USING_PC
 
+#ifndef DEBUG_LEVEL
 #define DEBUG_LEVEL 1
+#endif
 
 #define ENABLE_U2F
 #define ENABLE_U2F_EXTENSIONS
+// RFC 6979 nonces for ECDSA, so signatures repeat for the same key and data
+#define ENABLE_DETERMINISTIC_ECDSA
 //#define BRIDGE_TO_WALLET
 
+// Number of CTAPHID channels that can be reassembling a message at once
+#define CTAPHID_BUFFER_POOL_SIZE    10
+
+// Channels the simulator can track, e.g. for a load generator
+#define CTAPHID_MAX_CIDS            4096
+#define CTAPHID_CID_INDEX_SIZE      8192
+
+// getNextAssertion responses signed ahead while the main loop is idle
+#define NEXT_ASSERTION_PRECOMPUTE   4
+
 void printing_init();
 
 //                              0xRRGGBB
@@ -0,0 +1,98 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+
+// AES-256-GCM encryption throughput for each pairing of AES and GHASH
+// backends the CPU supports: a 64 byte credential secret, a 1 KB record
+// and a 16 KB backup chunk, each with 32 bytes of AAD.
+//
+//  usage: bench_aes_gcm [seconds per run]
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "aes_gcm.h"
+
+static const uint32_t sizes[] = {64, 1024, 16384};
+
+static double now()
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+// @return bytes per second
+static double run(aes_gcm_ctx * ctx, uint8_t * msg, uint32_t len, double secs, uint8_t * tag)
+{
+    static const uint8_t iv[AES_GCM_IV_SIZE] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    uint8_t aad[32];
+    double t1, t2;
+    uint64_t bytes = 0;
+    int i;
+
+    memset(aad, 0xaa, sizeof(aad));
+    t1 = now();
+    do
+    {
+        for (i = 0; i < 100; i++)
+        {
+            crypto_aes256_gcm_encrypt(ctx, iv, aad, sizeof(aad), msg, len, tag);
+        }
+        bytes += 100 * len;
+        t2 = now();
+    }
+    while (t2 - t1 < secs);
+
+    return bytes / (t2 - t1);
+}
+
+int main(int argc, char * argv[])
+{
+    double secs = argc > 1 ? atof(argv[1]) : 0.5;
+    static uint8_t msg[16384];
+    uint8_t key[32], tag[16];
+    aes_gcm_ctx ctx;
+    unsigned int i;
+    int aes, gcm;
+
+    for (i = 0; i < sizeof(key); i++)
+    {
+        key[i] = i * 3 + 1;
+    }
+
+    printf("%-10s %-8s", "aes", "ghash");
+    for (i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++)
+    {
+        printf(" %12u B", sizes[i]);
+    }
+    printf("\n");
+
+    for (aes = AES256_BACKEND_PORTABLE; aes < AES256_BACKEND_COUNT; aes++)
+    {
+        if (!aes256_select_backend(aes))
+        {
+            continue;
+        }
+        for (gcm = AES_GCM_BACKEND_TABLE; gcm < AES_GCM_BACKEND_COUNT; gcm++)
+        {
+            if (!crypto_aes256_gcm_select_backend(gcm))
+            {
+                continue;
+            }
+            crypto_aes256_gcm_init(&ctx, key);
+            printf("%-10s %-8s", aes256_backend_name(), crypto_aes256_gcm_backend_name());
+            for (i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++)
+            {
+                printf(" %7.1f MB/s", run(&ctx, msg, sizes[i], secs, tag) / 1e6);
+            }
+            printf("\n");
+        }
+    }
+    return 0;
+}
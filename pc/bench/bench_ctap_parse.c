@@ -0,0 +1,307 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+
+// CTAP2 request parsing rate, on requests shaped like the ones browsers
+// send: makeCredential with a full size user entity and a 20 credential
+// excludeList, getAssertion with a 20 credential allowList and hmac-secret,
+// and clientPin getPinToken.
+//
+//  usage: bench_ctap_parse [seconds per run]
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cbor.h"
+#include "ctap.h"
+#include "ctap_parse.h"
+#include "cose_key.h"
+
+#define BENCH_CREDENTIALS   20
+
+static CTAP_makeCredential MC;
+static CTAP_getAssertion GA;
+static CTAP_clientPin CP;
+
+static double now()
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+static void fill(uint8_t * buf, int len, uint8_t seed)
+{
+    int i;
+    for (i = 0; i < len; i++)
+    {
+        buf[i] = seed + i * 7;
+    }
+}
+
+static void encode_string(CborEncoder * map, const char * key, char c, int len)
+{
+    char text[ICON_LIMIT];
+    memset(text, c, len);
+    cbor_encode_text_stringz(map, key);
+    cbor_encode_text_string(map, text, len);
+}
+
+static void encode_credentials(CborEncoder * map, int key)
+{
+    CborEncoder arr, cred;
+    uint8_t id[sizeof(CredentialId)];
+    int i;
+
+    cbor_encode_int(map, key);
+    cbor_encoder_create_array(map, &arr, BENCH_CREDENTIALS);
+    for (i = 0; i < BENCH_CREDENTIALS; i++)
+    {
+        fill(id, sizeof(id), i);
+        cbor_encoder_create_map(&arr, &cred, 2);
+        cbor_encode_text_stringz(&cred, "id");
+        cbor_encode_byte_string(&cred, id, sizeof(id));
+        cbor_encode_text_stringz(&cred, "type");
+        cbor_encode_text_stringz(&cred, "public-key");
+        cbor_encoder_close_container(&arr, &cred);
+    }
+    cbor_encoder_close_container(map, &arr);
+}
+
+static void encode_cose_key(CborEncoder * map)
+{
+    CborEncoder cose;
+    uint8_t xy[32];
+
+    cbor_encoder_create_map(map, &cose, 5);
+    cbor_encode_int(&cose, COSE_KEY_LABEL_KTY);
+    cbor_encode_int(&cose, COSE_KEY_KTY_EC2);
+    cbor_encode_int(&cose, COSE_KEY_LABEL_ALG);
+    cbor_encode_int(&cose, -25);     // ECDH-ES + HKDF-256
+    cbor_encode_int(&cose, COSE_KEY_LABEL_CRV);
+    cbor_encode_int(&cose, COSE_KEY_CRV_P256);
+    fill(xy, sizeof(xy), 0x11);
+    cbor_encode_int(&cose, COSE_KEY_LABEL_X);
+    cbor_encode_byte_string(&cose, xy, sizeof(xy));
+    fill(xy, sizeof(xy), 0x22);
+    cbor_encode_int(&cose, COSE_KEY_LABEL_Y);
+    cbor_encode_byte_string(&cose, xy, sizeof(xy));
+    cbor_encoder_close_container(map, &cose);
+}
+
+static int encode_make_credential(uint8_t * buf, int size)
+{
+    CborEncoder enc, map, sub, param;
+    uint8_t data[USER_ID_MAX_SIZE];
+    // EdDSA, PS256 and RS256 before ES256, like Chrome lists them
+    static const int algs[] = {-8, -37, -257, COSE_ALG_ES256};
+    unsigned int i;
+
+    cbor_encoder_init(&enc, buf, size, 0);
+    cbor_encoder_create_map(&enc, &map, 8);
+
+    fill(data, CLIENT_DATA_HASH_SIZE, 1);
+    cbor_encode_int(&map, MC_clientDataHash);
+    cbor_encode_byte_string(&map, data, CLIENT_DATA_HASH_SIZE);
+
+    cbor_encode_int(&map, MC_rp);
+    cbor_encoder_create_map(&map, &sub, 2);
+    cbor_encode_text_stringz(&sub, "id");
+    cbor_encode_text_stringz(&sub, "accounts.example.com");
+    encode_string(&sub, "name", 'r', RP_NAME_LIMIT - 1);
+    cbor_encoder_close_container(&map, &sub);
+
+    cbor_encode_int(&map, MC_user);
+    cbor_encoder_create_map(&map, &sub, 4);
+    fill(data, USER_ID_MAX_SIZE, 2);
+    cbor_encode_text_stringz(&sub, "id");
+    cbor_encode_byte_string(&sub, data, USER_ID_MAX_SIZE);
+    encode_string(&sub, "icon", 'i', ICON_LIMIT - 1);
+    encode_string(&sub, "name", 'n', USER_NAME_LIMIT - 1);
+    encode_string(&sub, "displayName", 'd', DISPLAY_NAME_LIMIT - 1);
+    cbor_encoder_close_container(&map, &sub);
+
+    cbor_encode_int(&map, MC_pubKeyCredParams);
+    cbor_encoder_create_array(&map, &sub, sizeof(algs)/sizeof(algs[0]));
+    for (i = 0; i < sizeof(algs)/sizeof(algs[0]); i++)
+    {
+        cbor_encoder_create_map(&sub, &param, 2);
+        cbor_encode_text_stringz(&param, "alg");
+        cbor_encode_int(&param, algs[i]);
+        cbor_encode_text_stringz(&param, "type");
+        cbor_encode_text_stringz(&param, "public-key");
+        cbor_encoder_close_container(&sub, &param);
+    }
+    cbor_encoder_close_container(&map, &sub);
+
+    encode_credentials(&map, MC_excludeList);
+
+    cbor_encode_int(&map, MC_options);
+    cbor_encoder_create_map(&map, &sub, 1);
+    cbor_encode_text_stringz(&sub, "rk");
+    cbor_encode_boolean(&sub, 1);
+    cbor_encoder_close_container(&map, &sub);
+
+    fill(data, 16, 3);
+    cbor_encode_int(&map, MC_pinAuth);
+    cbor_encode_byte_string(&map, data, 16);
+    cbor_encode_int(&map, MC_pinProtocol);
+    cbor_encode_int(&map, 1);
+
+    cbor_encoder_close_container(&enc, &map);
+    return cbor_encoder_get_buffer_size(&enc, buf);
+}
+
+static int encode_get_assertion(uint8_t * buf, int size)
+{
+    CborEncoder enc, map, sub, hs;
+    uint8_t data[64];
+
+    cbor_encoder_init(&enc, buf, size, 0);
+    cbor_encoder_create_map(&enc, &map, 7);
+
+    cbor_encode_int(&map, GA_rpId);
+    cbor_encode_text_stringz(&map, "accounts.example.com");
+
+    fill(data, CLIENT_DATA_HASH_SIZE, 4);
+    cbor_encode_int(&map, GA_clientDataHash);
+    cbor_encode_byte_string(&map, data, CLIENT_DATA_HASH_SIZE);
+
+    encode_credentials(&map, GA_allowList);
+
+    cbor_encode_int(&map, GA_extensions);
+    cbor_encoder_create_map(&map, &sub, 1);
+    cbor_encode_text_stringz(&sub, "hmac-secret");
+    cbor_encoder_create_map(&sub, &hs, 3);
+    cbor_encode_int(&hs, EXT_HMAC_SECRET_COSE_KEY);
+    encode_cose_key(&hs);
+    fill(data, 64, 5);
+    cbor_encode_int(&hs, EXT_HMAC_SECRET_SALT_ENC);
+    cbor_encode_byte_string(&hs, data, 64);
+    cbor_encode_int(&hs, EXT_HMAC_SECRET_SALT_AUTH);
+    cbor_encode_byte_string(&hs, data, 16);
+    cbor_encoder_close_container(&sub, &hs);
+    cbor_encoder_close_container(&map, &sub);
+
+    cbor_encode_int(&map, GA_options);
+    cbor_encoder_create_map(&map, &sub, 2);
+    cbor_encode_text_stringz(&sub, "up");
+    cbor_encode_boolean(&sub, 1);
+    cbor_encode_text_stringz(&sub, "uv");
+    cbor_encode_boolean(&sub, 0);
+    cbor_encoder_close_container(&map, &sub);
+
+    fill(data, 16, 6);
+    cbor_encode_int(&map, GA_pinAuth);
+    cbor_encode_byte_string(&map, data, 16);
+    cbor_encode_int(&map, GA_pinProtocol);
+    cbor_encode_int(&map, 1);
+
+    cbor_encoder_close_container(&enc, &map);
+    return cbor_encoder_get_buffer_size(&enc, buf);
+}
+
+static int encode_client_pin(uint8_t * buf, int size)
+{
+    CborEncoder enc, map;
+    uint8_t data[16];
+
+    cbor_encoder_init(&enc, buf, size, 0);
+    cbor_encoder_create_map(&enc, &map, 4);
+
+    cbor_encode_int(&map, CP_pinProtocol);
+    cbor_encode_int(&map, 1);
+    cbor_encode_int(&map, CP_subCommand);
+    cbor_encode_int(&map, CP_cmdGetPinToken);
+    cbor_encode_int(&map, CP_keyAgreement);
+    encode_cose_key(&map);
+    fill(data, 16, 7);
+    cbor_encode_int(&map, CP_pinHashEnc);
+    cbor_encode_byte_string(&map, data, 16);
+
+    cbor_encoder_close_container(&enc, &map);
+    return cbor_encoder_get_buffer_size(&enc, buf);
+}
+
+static uint8_t parse(int cmd, uint8_t * req, int len)
+{
+    CborEncoder encoder;
+
+    switch (cmd)
+    {
+        case CTAP_MAKE_CREDENTIAL:
+            return ctap_parse_make_credential(&MC, &encoder, req, len);
+        case CTAP_GET_ASSERTION:
+            return ctap_parse_get_assertion(&GA, req, len);
+        default:
+            return ctap_parse_client_pin(&CP, req, len);
+    }
+}
+
+// @return requests per second
+static double run(int cmd, uint8_t * req, int len, double secs)
+{
+    double t1, t2;
+    uint64_t count = 0;
+    int i;
+
+    t1 = now();
+    do
+    {
+        for (i = 0; i < 100; i++)
+        {
+            if (parse(cmd, req, len) != 0)
+            {
+                printf("parse error\n");
+                exit(1);
+            }
+        }
+        count += 100;
+        t2 = now();
+    }
+    while (t2 - t1 < secs);
+
+    return count / (t2 - t1);
+}
+
+int main(int argc, char * argv[])
+{
+    double secs = argc > 1 ? atof(argv[1]) : 0.5;
+    static uint8_t req[CTAP_MAX_MESSAGE_SIZE * 4];
+    static const struct
+    {
+        const char * name;
+        int cmd;
+        int (*encode)(uint8_t *, int);
+    } requests[] = {
+        {"makeCredential", CTAP_MAKE_CREDENTIAL, encode_make_credential},
+        {"getAssertion", CTAP_GET_ASSERTION, encode_get_assertion},
+        {"clientPin", CTAP_CLIENT_PIN, encode_client_pin},
+    };
+    unsigned int i;
+    double rate;
+    int len;
+
+    printf("%-16s %8s %12s %10s\n", "request", "bytes", "parses/s", "us/parse");
+    for (i = 0; i < sizeof(requests)/sizeof(requests[0]); i++)
+    {
+        len = requests[i].encode(req, sizeof(req));
+        rate = run(requests[i].cmd, req, len, secs);
+        printf("%-16s %8d %12.0f %10.2f\n", requests[i].name, len, rate, 1e6 / rate);
+    }
+
+    // Everything came through
+    if (MC.credInfo.user.id.size != USER_ID_MAX_SIZE || MC.excludeListSize != BENCH_CREDENTIALS ||
+        GA.credLen != BENCH_CREDENTIALS || GA.extensions.hmac_secret_present != EXT_HMAC_SECRET_PARSED ||
+        CP.subCommand != CP_cmdGetPinToken)
+    {
+        printf("request not parsed in full\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,101 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+
+// Hashes messages of the sizes the authenticator sees with every SHA-256
+// backend the CPU supports: a 32 byte hash (PIN and key agreement hashes),
+// a 64 byte block and a 7609 byte CTAPHID message.
+//
+//  usage: bench_sha256 [seconds per run]
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "sha256.h"
+
+static const size_t sizes[] = {32, 64, 7609};
+
+static double now()
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+// @return bytes per second
+static double run(const uint8_t * msg, size_t len, double secs, uint8_t * hash)
+{
+    SHA256_CTX ctx;
+    double t1, t2;
+    uint64_t bytes = 0;
+    int i;
+
+    t1 = now();
+    do
+    {
+        for (i = 0; i < 1000; i++)
+        {
+            sha256_init(&ctx);
+            sha256_update(&ctx, msg, len);
+            sha256_final(&ctx, hash);
+        }
+        bytes += 1000 * len;
+        t2 = now();
+    }
+    while (t2 - t1 < secs);
+
+    return bytes / (t2 - t1);
+}
+
+int main(int argc, char * argv[])
+{
+    double secs = argc > 1 ? atof(argv[1]) : 0.5;
+    uint8_t msg[7609];
+    uint8_t hash[32], ref[3][32];
+    double portable[3], rate;
+    unsigned int i;
+    int backend;
+
+    for (i = 0; i < sizeof(msg); i++)
+    {
+        msg[i] = i * 7 + 1;
+    }
+
+    printf("%-10s", "backend");
+    for (i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++)
+    {
+        printf(" %19zu B", sizes[i]);
+    }
+    printf("\n");
+
+    for (backend = SHA256_BACKEND_PORTABLE; backend < SHA256_BACKEND_COUNT; backend++)
+    {
+        if (!sha256_select_backend(backend))
+        {
+            continue;
+        }
+        printf("%-10s", sha256_backend_name());
+        for (i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++)
+        {
+            rate = run(msg, sizes[i], secs, hash);
+            if (backend == SHA256_BACKEND_PORTABLE)
+            {
+                portable[i] = rate;
+                memmove(ref[i], hash, 32);
+            }
+            else if (memcmp(ref[i], hash, 32) != 0)
+            {
+                printf("\n%s hash of %zu bytes differs from the portable one\n", sha256_backend_name(), sizes[i]);
+                return 1;
+            }
+            printf(" %8.1f MB/s (%4.1fx)", rate / 1e6, rate / portable[i]);
+        }
+        printf("\n");
+    }
+    return 0;
+}
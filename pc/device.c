@@ -4,6 +4,9 @@
 // http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
 // http://opensource.org/licenses/MIT>, at your option. This file may not be
 // copied, modified, or distributed except according to those terms.
+#ifdef __linux__
+#define _GNU_SOURCE     // recvmmsg/sendmmsg
+#endif
 #include <sys/time.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -15,22 +18,84 @@
 #include <string.h>
 #include <unistd.h>
 #include <signal.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
+#endif
 
 #include "device.h"
 #include "cbor.h"
 #include "util.h"
 #include "log.h"
 #include "ctaphid.h"
+#include "ctap.h"
 
 #define RK_NUM  50
 
 struct ResidentKeyStore {
     CTAP_residentKey rks[RK_NUM];
-} RK_STORE;
+};
+static AUTHENTICATOR_LOCAL struct ResidentKeyStore * RK_STORE;
 
 void authenticator_initialize();
+static void authenticator_set_files();
 
-uint32_t __device_status = 0;
+// Every thread hosts its own authenticator (see server.c).  Instance n
+// listens on port 8111+n and keeps its state in files suffixed with _n.
+static AUTHENTICATOR_LOCAL int instance = 0;
+
+void device_set_instance(int n)
+{
+    instance = n;
+}
+
+// Set by server.c before any instance starts.  A hosted instance reboots by
+// returning to server.c, which starts it again on a new thread, and server.c
+// handles SIGINT for all of them.
+static int hosted = 0;
+static _Atomic int shutdown_requested = 0;
+static int shutdown_fd = -1;    // becomes readable on shutdown, wakes every instance
+static AUTHENTICATOR_LOCAL int reboot_requested = 0;
+
+void device_hosting_init()
+{
+    hosted = 1;
+#ifdef __linux__
+    if ((shutdown_fd = eventfd(0, EFD_NONBLOCK)) < 0)
+    {
+        perror( "eventfd" );
+        exit(1);
+    }
+#endif
+}
+
+// Make every hosted instance's main loop stop
+void device_shutdown()
+{
+    uint64_t one = 1;
+    shutdown_requested = 1;
+    if (shutdown_fd >= 0 && write(shutdown_fd, &one, sizeof(one)) < 0)
+    {
+        perror( "write eventfd" );
+    }
+}
+
+int device_shutdown_requested()
+{
+    return shutdown_requested;
+}
+
+int device_reboot_requested()
+{
+    return reboot_requested;
+}
+
+AUTHENTICATOR_LOCAL uint32_t __device_status = 0;
 void device_set_status(uint32_t status)
 {
     if (status != CTAPHID_STATUS_IDLE && __device_status != status)
@@ -42,10 +107,223 @@ void device_set_status(uint32_t status)
 
 
 
+// Each channel's replies go to the address that sent its INIT, found by
+// cid % UDP_CID_ADDRS.  Channels without one, or whose slot was taken by
+// another channel, are answered on the usual client port.
+#define UDP_CID_ADDRS   4096
+
+static AUTHENTICATOR_LOCAL struct {
+    uint32_t cid;
+    struct sockaddr_in addr;
+} cid_addrs[UDP_CID_ADDRS];
+static AUTHENTICATOR_LOCAL struct sockaddr_in default_addr;
+
+static void udp_set_cid_addr(uint32_t cid, const struct sockaddr_in * addr)
+{
+    cid_addrs[cid % UDP_CID_ADDRS].cid = cid;
+    cid_addrs[cid % UDP_CID_ADDRS].addr = *addr;
+}
+
+// Learn the sender of an INIT frame
+static void udp_frame_received(const uint8_t * frame, int len, const struct sockaddr_in * addr)
+{
+    uint32_t cid;
+    if (len >= 5 && frame[4] == CTAPHID_INIT)
+    {
+        memmove(&cid, frame, 4);
+        udp_set_cid_addr(cid, addr);
+    }
+}
+
+static const struct sockaddr_in * udp_frame_addr(const uint8_t * frame)
+{
+    uint32_t cid, newcid;
+    memmove(&cid, frame, 4);
+
+    const struct sockaddr_in * addr = &default_addr;
+    if (cid_addrs[cid % UDP_CID_ADDRS].cid == cid && cid_addrs[cid % UDP_CID_ADDRS].addr.sin_family == AF_INET)
+    {
+        addr = &cid_addrs[cid % UDP_CID_ADDRS].addr;
+    }
+
+    // A channel allocated on the broadcast channel belongs to its sender
+    if (cid == CTAPHID_BROADCAST_CID && frame[4] == CTAPHID_INIT)
+    {
+        memmove(&newcid, frame + 7 + 8, 4);
+        udp_set_cid_addr(newcid, addr);
+    }
+    return addr;
+}
+
+#ifdef __linux__
+static AUTHENTICATOR_LOCAL int epollfd = -1;
+static AUTHENTICATOR_LOCAL int timerfd = -1;
+
+// Number of HID frames moved per recvmmsg/sendmmsg call
+#define UDP_BATCH_SIZE  32
+
+static AUTHENTICATOR_LOCAL uint8_t rx_frames[UDP_BATCH_SIZE][HID_MESSAGE_SIZE];
+static AUTHENTICATOR_LOCAL struct sockaddr_in rx_addrs[UDP_BATCH_SIZE];
+static AUTHENTICATOR_LOCAL struct iovec rx_iov[UDP_BATCH_SIZE];
+static AUTHENTICATOR_LOCAL struct mmsghdr rx_msgs[UDP_BATCH_SIZE];
+static AUTHENTICATOR_LOCAL int rx_count = 0;
+static AUTHENTICATOR_LOCAL int rx_next = 0;
+
+static AUTHENTICATOR_LOCAL uint8_t tx_frames[UDP_BATCH_SIZE][HID_MESSAGE_SIZE];
+static AUTHENTICATOR_LOCAL struct sockaddr_in tx_addrs[UDP_BATCH_SIZE];
+static AUTHENTICATOR_LOCAL struct iovec tx_iov[UDP_BATCH_SIZE];
+static AUTHENTICATOR_LOCAL struct mmsghdr tx_msgs[UDP_BATCH_SIZE];
+static AUTHENTICATOR_LOCAL int tx_count = 0;
+
+// Packets and CTAPHID timeouts both wake the main loop through epoll,
+// so an idle simulator sleeps instead of polling.
+static void event_loop_init(int fd)
+{
+    struct epoll_event ev;
+
+    if ((epollfd = epoll_create1(0)) < 0)
+    {
+        perror( "epoll_create1" );
+        exit(1);
+    }
+    if ((timerfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK)) < 0)
+    {
+        perror( "timerfd_create" );
+        exit(1);
+    }
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    if (epoll_ctl(epollfd, EPOLL_CTL_ADD, fd, &ev) < 0)
+    {
+        perror( "epoll_ctl" );
+        exit(1);
+    }
+    ev.data.fd = timerfd;
+    if (epoll_ctl(epollfd, EPOLL_CTL_ADD, timerfd, &ev) < 0)
+    {
+        perror( "epoll_ctl" );
+        exit(1);
+    }
+    if (shutdown_fd >= 0)
+    {
+        ev.data.fd = shutdown_fd;
+        if (epoll_ctl(epollfd, EPOLL_CTL_ADD, shutdown_fd, &ev) < 0)
+        {
+            perror( "epoll_ctl" );
+            exit(1);
+        }
+    }
+}
+
+// Sleep until a packet arrives or the next channel timeout is due
+static void event_loop_wait()
+{
+    struct itimerspec its;
+    struct epoll_event events[3];
+    uint64_t expirations;
+    int32_t timeout = ctaphid_next_timeout();
+    int i, n;
+
+    // A zero it_value disarms the timer, so round up to 1 ns
+    memset(&its, 0, sizeof(its));
+    if (timeout >= 0)
+    {
+        its.it_value.tv_sec = timeout / 1000;
+        its.it_value.tv_nsec = (timeout % 1000) * 1000000L + 1;
+    }
+    if (timerfd_settime(timerfd, 0, &its, NULL) < 0)
+    {
+        perror( "timerfd_settime" );
+        exit(1);
+    }
+
+    n = epoll_wait(epollfd, events, sizeof(events)/sizeof(events[0]), -1);
+    if (n < 0 && errno != EINTR)
+    {
+        perror( "epoll_wait" );
+        exit(1);
+    }
+    for (i = 0; i < n; i++)
+    {
+        if (events[i].data.fd == timerfd)
+        {
+            if (read(timerfd, &expirations, sizeof(expirations)) < 0 && errno != EAGAIN)
+            {
+                perror( "read timerfd" );
+                exit(1);
+            }
+        }
+    }
+}
+
+static void udp_batch_init()
+{
+    int i;
+    memset(rx_msgs, 0, sizeof(rx_msgs));
+    memset(tx_msgs, 0, sizeof(tx_msgs));
+    for (i = 0; i < UDP_BATCH_SIZE; i++)
+    {
+        rx_iov[i].iov_base = rx_frames[i];
+        rx_iov[i].iov_len = HID_MESSAGE_SIZE;
+        rx_msgs[i].msg_hdr.msg_iov = rx_iov + i;
+        rx_msgs[i].msg_hdr.msg_iovlen = 1;
+        rx_msgs[i].msg_hdr.msg_name = rx_addrs + i;
+
+        tx_iov[i].iov_base = tx_frames[i];
+        tx_msgs[i].msg_hdr.msg_iov = tx_iov + i;
+        tx_msgs[i].msg_hdr.msg_iovlen = 1;
+        tx_msgs[i].msg_hdr.msg_name = tx_addrs + i;
+        tx_msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+    }
+}
+
+// Send all queued frames
+static void udp_flush(int fd)
+{
+    int sent = 0;
+    int n;
+    while (sent < tx_count)
+    {
+        n = sendmmsg( fd, tx_msgs + sent, tx_count - sent, 0 );
+        if ( n < 0 ) {
+            if (errno == EINTR) continue;
+            perror( "sendmmsg failed" );
+            exit(1);
+        }
+        sent += n;
+    }
+    tx_count = 0;
+}
+
+// Read every frame that is already queued on the socket
+static int udp_recv_batch(int fd)
+{
+    int i;
+    for (i = 0; i < UDP_BATCH_SIZE; i++)
+    {
+        rx_msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+    }
+    int n = recvmmsg( fd, rx_msgs, UDP_BATCH_SIZE, MSG_DONTWAIT, NULL );
+    if ( n < 0 ) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+        {
+            return 0;
+        }
+        perror( "recvmmsg failed" );
+        exit(1);
+    }
+    rx_next = 0;
+    rx_count = n;
+    return n;
+}
+#endif
+
 int udp_server()
 {
-    static bool run_already = false;
-    static int fd = -1;
+    static AUTHENTICATOR_LOCAL bool run_already = false;
+    static AUTHENTICATOR_LOCAL int fd = -1;
     if (run_already && fd >= 0) return fd;
     run_already = true;
 
@@ -54,6 +332,7 @@ int udp_server()
         return 1;
     }
 
+#ifndef __linux__
     struct timeval read_timeout;
     read_timeout.tv_sec = 0;
     read_timeout.tv_usec = 10;
@@ -62,20 +341,67 @@ int udp_server()
         perror( "setsockopt" );
         exit(1);
     }
+#endif
 
     struct sockaddr_in serveraddr;
     memset( &serveraddr, 0, sizeof(serveraddr) );
     serveraddr.sin_family = AF_INET;
-    serveraddr.sin_port = htons( 8111 );
+    serveraddr.sin_port = htons( 8111 + instance );
     serveraddr.sin_addr.s_addr = htonl( INADDR_ANY );
 
     if ( bind(fd, (struct sockaddr *)&serveraddr, sizeof(serveraddr)) < 0 ) {
         perror( "bind failed" );
         exit(1);
     }
+
+    memset( cid_addrs, 0, sizeof(cid_addrs) );
+    memset( &default_addr, 0, sizeof(default_addr) );
+    default_addr.sin_family = AF_INET;
+    default_addr.sin_port = htons( 7112 + instance );
+    default_addr.sin_addr.s_addr = htonl( 0x7f000001 ); // (127.0.0.1)
+
+#ifdef __linux__
+    udp_batch_init();
+    event_loop_init(fd);
+#endif
     return fd;
 }
 
+#ifdef __linux__
+int udp_recv(int fd, uint8_t * buf, int size)
+{
+    // Anything written while handling the last frame goes out in one call
+    udp_flush(fd);
+
+    if (rx_next == rx_count)
+    {
+        if (udp_recv_batch(fd) == 0)
+        {
+            // Don't sleep while there are assertions to sign ahead, or
+            // when the loop is about to stop
+            if (ctap_idle_pending() || shutdown_requested || reboot_requested)
+            {
+                return 0;
+            }
+            event_loop_wait();
+            if (udp_recv_batch(fd) == 0)
+            {
+                return 0;
+            }
+        }
+    }
+
+    int length = rx_msgs[rx_next].msg_len;
+    if (length > size)
+    {
+        length = size;
+    }
+    memmove(buf, rx_frames[rx_next], length);
+    udp_frame_received(buf, length, rx_addrs + rx_next);
+    rx_next++;
+    return length;
+}
+#else
 int udp_recv(int fd, uint8_t * buf, int size)
 {
 
@@ -95,31 +421,46 @@ int udp_recv(int fd, uint8_t * buf, int size)
     {
 
     }
-    int length = recvfrom( fd, buf, size, 0, NULL, 0 );
+    struct sockaddr_in addr;
+    socklen_t addrlen = sizeof(addr);
+    int length = recvfrom( fd, buf, size, 0, (struct sockaddr *)&addr, &addrlen );
     if ( length < 0 ) {
         perror( "recvfrom failed" );
         exit(1);
     }
+    udp_frame_received(buf, length, &addr);
     return length;
 }
+#endif
 
 
 void udp_send(int fd, uint8_t * buf, int size)
 {
-    struct sockaddr_in serveraddr;
-    memset( &serveraddr, 0, sizeof(serveraddr) );
-    serveraddr.sin_family = AF_INET;
-    serveraddr.sin_port = htons( 7112 );
-    serveraddr.sin_addr.s_addr = htonl( 0x7f000001 ); // (127.0.0.1)
-
-    if (sendto( fd, buf, size, 0, (struct sockaddr *)&serveraddr, sizeof(serveraddr)) < 0 ) {
+    const struct sockaddr_in * addr = udp_frame_addr(buf);
+#ifdef __linux__
+    if (tx_count == UDP_BATCH_SIZE)
+    {
+        udp_flush(fd);
+    }
+    memmove(tx_frames[tx_count], buf, size);
+    tx_iov[tx_count].iov_len = size;
+    tx_addrs[tx_count] = *addr;
+    tx_count++;
+#else
+    if (sendto( fd, buf, size, 0, (struct sockaddr *)addr, sizeof(*addr)) < 0 ) {
         perror( "sendto failed" );
         exit(1);
     }
+#endif
 }
 
 void udp_close(int fd)
 {
+#ifdef __linux__
+    udp_flush(fd);
+    close(epollfd);
+    close(timerfd);
+#endif
     close(fd);
 }
 
@@ -134,7 +475,7 @@ uint32_t millis()
 }
 
 
-static int serverfd = 0;
+static AUTHENTICATOR_LOCAL int serverfd = 0;
 
 void usbhid_init()
 {
@@ -142,7 +483,8 @@ void usbhid_init()
     serverfd = udp_server();
 }
 
-// Receive 64 byte USB HID message, don't block, return size of packet, return 0 if nothing
+// Receive 64 byte USB HID message, return size of packet, return 0 if nothing.
+// On Linux this sleeps until a packet arrives or a channel timeout is due.
 int usbhid_recv(uint8_t * msg)
 {
     int l = udp_recv(serverfd, msg, HID_MESSAGE_SIZE);
@@ -156,7 +498,11 @@ int usbhid_recv(uint8_t * msg)
     {
         printf1(TAG_RED, "MAGIC REBOOT command recieved!\r\n");
         memset(msg,0,64);
-        exit(100);
+        if (!hosted)
+        {
+            exit(100);
+        }
+        reboot_requested = 1;
         return 0;
     }
 
@@ -183,10 +529,14 @@ void int_handler(int i)
 
 void device_init()
 {
-    signal(SIGINT, int_handler);
+    if (!hosted)
+    {
+        signal(SIGINT, int_handler);
+    }
 
     usbhid_init();
 
+    authenticator_set_files();
     authenticator_initialize();
 
     ctaphid_init();
@@ -229,7 +579,7 @@ int ctap_user_verification(uint8_t arg)
 
 uint32_t ctap_atomic_count(int sel)
 {
-    static uint32_t counter1 = 25;
+    static AUTHENTICATOR_LOCAL uint32_t counter1 = 25;
     /*return 713;*/
     if (sel == 0)
     {
@@ -263,230 +613,128 @@ int ctap_generate_rng(uint8_t * dst, size_t num)
 }
 
 
-const char * state_file = "authenticator_state.bin";
-const char * backup_file = "authenticator_state2.bin";
-const char * rk_file = "resident_keys.bin";
+static AUTHENTICATOR_LOCAL char state_file[64];
+static AUTHENTICATOR_LOCAL char backup_file[64];
+static AUTHENTICATOR_LOCAL char rk_file[64];
 
-void authenticator_read_state(AuthenticatorState * state)
+// Instance 0 keeps the original file names
+static void authenticator_set_files()
 {
-    FILE * f;
-    int ret;
-
-    f = fopen(state_file, "rb");
-    if (f== NULL)
+    if (instance == 0)
     {
-        perror("fopen");
-        exit(1);
+        snprintf(state_file, sizeof(state_file), "authenticator_state.bin");
+        snprintf(backup_file, sizeof(backup_file), "authenticator_state2.bin");
+        snprintf(rk_file, sizeof(rk_file), "resident_keys.bin");
     }
-
-    ret = fread(state, 1, sizeof(AuthenticatorState), f);
-    fclose(f);
-    if(ret != sizeof(AuthenticatorState))
+    else
     {
-        perror("fwrite");
-        exit(1);
+        snprintf(state_file, sizeof(state_file), "authenticator_state_%d.bin", instance);
+        snprintf(backup_file, sizeof(backup_file), "authenticator_state2_%d.bin", instance);
+        snprintf(rk_file, sizeof(rk_file), "resident_keys_%d.bin", instance);
     }
-
 }
 
-void authenticator_read_backup_state(AuthenticatorState * state )
-{
-    FILE * f;
-    int ret;
+// State and resident keys live in memory mapped files.  Updates are copied
+// into the mapping and only the pages they touch are written back.
+static AUTHENTICATOR_LOCAL AuthenticatorState * state_map;
+static AUTHENTICATOR_LOCAL AuthenticatorState * backup_map;
 
-    f = fopen(backup_file, "rb");
-    if (f== NULL)
+// Map @size bytes of file @name, creating it erased (0xff) if it is new.
+static void * map_file(const char * name, size_t size)
+{
+    struct stat st;
+    void * p;
+    int fd = open(name, O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
     {
-        perror("fopen");
+        perror("open");
         exit(1);
     }
-
-    ret = fread(state, 1, sizeof(AuthenticatorState), f);
-    fclose(f);
-    if(ret != sizeof(AuthenticatorState))
+    if (fstat(fd, &st) < 0)
     {
-        perror("fwrite");
+        perror("fstat");
         exit(1);
     }
-}
-
-void authenticator_write_state(AuthenticatorState * state, int backup)
-{
-    FILE * f;
-    int ret;
-
-    if (! backup)
+    if (st.st_size != 0 && st.st_size < (off_t)size)
     {
-        f = fopen(state_file, "wb+");
-        if (f== NULL)
-        {
-            perror("fopen");
-            exit(1);
-        }
-        ret = fwrite(state, 1, sizeof(AuthenticatorState), f);
-        fclose(f);
-        if (ret != sizeof(AuthenticatorState))
-        {
-            perror("fwrite");
-            exit(1);
-        }
+        printf2(TAG_ERR, "%s is too short\n", name);
+        exit(1);
     }
-    else
+    if (st.st_size == 0)
     {
-
-        f = fopen(backup_file, "wb+");
-        if (f== NULL)
+        printf("%s does not exist, creating it\n", name);
+        if (ftruncate(fd, size) < 0)
         {
-            perror("fopen");
-            exit(1);
-        }
-        ret = fwrite(state, 1, sizeof(AuthenticatorState), f);
-        fclose(f);
-        if (ret != sizeof(AuthenticatorState))
-        {
-            perror("fwrite");
+            perror("ftruncate");
             exit(1);
         }
     }
-}
 
-// Return 1 yes backup is init'd, else 0
-int authenticator_is_backup_initialized()
-{
-    uint8_t header[16];
-    AuthenticatorState * state = (AuthenticatorState*) header;
-    FILE * f;
-    int ret;
-
-    printf("state file exists\n");
-    f = fopen(backup_file, "rb");
-    if (f== NULL)
+    p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED)
     {
-        printf("Warning, backup file doesn't exist\n");
-        return 0;
+        perror("mmap");
+        exit(1);
     }
 
-    ret = fread(header, 1, sizeof(header), f);
-    fclose(f);
-    if(ret != sizeof(header))
+    if (st.st_size == 0)
     {
-        perror("fwrite");
-        exit(1);
+        memset(p, 0xff, size);
     }
-
-    return state->is_initialized == INITIALIZED_MARKER;
-
+    return p;
 }
 
-// Return 1 yes backup is init'd, else 0
-/*int authenticator_is_initialized()*/
-/*{*/
-
-
-/*}*/
-
-static void sync_rk()
+// Schedule write back of the pages covering [p, p + len).  This is no less
+// durable than the fwrite/fclose it replaces, which didn't fsync either.
+static void sync_range(void * p, size_t len)
 {
-    FILE * f = fopen(rk_file, "wb+");
-    if (f== NULL)
-    {
-        perror("fopen");
-        exit(1);
-    }
-
-    int ret = fwrite(&RK_STORE, 1, sizeof(RK_STORE), f);
-    fclose(f);
-    if (ret != sizeof(RK_STORE))
+    uintptr_t page = sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t)p & ~(page - 1);
+    if (msync((void *)start, (uintptr_t)p + len - start, MS_ASYNC) != 0)
     {
-        perror("fwrite");
+        perror("msync");
         exit(1);
     }
 }
 
-void authenticator_initialize()
+void authenticator_read_state(AuthenticatorState * state)
 {
-    uint8_t header[16];
-    FILE * f;
-    int ret;
-    uint8_t * mem;
-    if (access(state_file, F_OK) != -1)
-    {
-        printf("state file exists\n");
-        f = fopen(state_file, "rb");
-        if (f== NULL)
-        {
-            perror("fopen");
-            exit(1);
-        }
-
-        ret = fread(header, 1, sizeof(header), f);
-        fclose(f);
-        if(ret != sizeof(header))
-        {
-            perror("fwrite");
-            exit(1);
-        }
-
-        // resident_keys
-        f = fopen(rk_file, "rb");
-        if (f== NULL)
-        {
-            perror("fopen");
-            exit(1);
-        }
-        ret = fread(&RK_STORE, 1, sizeof(RK_STORE), f);
-        fclose(f);
-        if(ret != sizeof(RK_STORE))
-        {
-            perror("fwrite");
-            exit(1);
-        }
-
-    }
-    else
-    {
-        printf("state file does not exist, creating it\n");
-        f = fopen(state_file, "wb+");
-        if (f== NULL)
-        {
-            perror("fopen");
-            exit(1);
-        }
-        mem = malloc(sizeof(AuthenticatorState));
-        memset(mem,0xff,sizeof(AuthenticatorState));
-        ret = fwrite(mem, 1, sizeof(AuthenticatorState), f);
-        free(mem);
-        fclose(f);
-        if (ret != sizeof(AuthenticatorState))
-        {
-            perror("fwrite");
-            exit(1);
-        }
+    memmove(state, state_map, sizeof(AuthenticatorState));
+}
 
-        f = fopen(backup_file, "wb+");
-        if (f== NULL)
-        {
-            perror("fopen");
-            exit(1);
-        }
-        mem = malloc(sizeof(AuthenticatorState));
-        memset(mem,0xff,sizeof(AuthenticatorState));
-        ret = fwrite(mem, 1, sizeof(AuthenticatorState), f);
-        free(mem);
-        fclose(f);
-        if (ret != sizeof(AuthenticatorState))
-        {
-            perror("fwrite");
-            exit(1);
-        }
+void authenticator_read_backup_state(AuthenticatorState * state )
+{
+    memmove(state, backup_map, sizeof(AuthenticatorState));
+}
 
-        // resident_keys
-        memset(&RK_STORE,0xff,sizeof(RK_STORE));
-        sync_rk();
+void authenticator_write_state(AuthenticatorState * state, int backup)
+{
+    AuthenticatorState * dst = backup ? backup_map : state_map;
+    memmove(dst, state, sizeof(AuthenticatorState));
+    sync_range(dst, sizeof(AuthenticatorState));
+}
 
+// Return 1 yes backup is init'd, else 0
+int authenticator_is_backup_initialized()
+{
+    return backup_map->is_initialized == INITIALIZED_MARKER;
+}
 
+// Release the instance's socket and files
+void device_close()
+{
+    usbhid_close();
+    munmap(state_map, sizeof(AuthenticatorState));
+    munmap(backup_map, sizeof(AuthenticatorState));
+    munmap(RK_STORE, sizeof(struct ResidentKeyStore));
+}
 
-    }
+void authenticator_initialize()
+{
+    state_map = map_file(state_file, sizeof(AuthenticatorState));
+    backup_map = map_file(backup_file, sizeof(AuthenticatorState));
+    RK_STORE = map_file(rk_file, sizeof(struct ResidentKeyStore));
 }
 
 void device_manage()
@@ -498,9 +746,8 @@ void device_manage()
 
 void ctap_reset_rk()
 {
-    memset(&RK_STORE,0xff,sizeof(RK_STORE));
-    sync_rk();
-
+    memset(RK_STORE, 0xff, sizeof(struct ResidentKeyStore));
+    sync_range(RK_STORE, sizeof(struct ResidentKeyStore));
 }
 
 uint32_t ctap_rk_size()
@@ -513,8 +760,8 @@ void ctap_store_rk(int index, CTAP_residentKey * rk)
 {
     if (index < RK_NUM)
     {
-        memmove(RK_STORE.rks + index, rk, sizeof(CTAP_residentKey));
-        sync_rk();
+        memmove(RK_STORE->rks + index, rk, sizeof(CTAP_residentKey));
+        sync_range(RK_STORE->rks + index, sizeof(CTAP_residentKey));
     }
     else
     {
@@ -526,15 +773,15 @@ void ctap_store_rk(int index, CTAP_residentKey * rk)
 
 void ctap_load_rk(int index, CTAP_residentKey * rk)
 {
-    memmove(rk, RK_STORE.rks + index, sizeof(CTAP_residentKey));
+    memmove(rk, RK_STORE->rks + index, sizeof(CTAP_residentKey));
 }
 
 void ctap_overwrite_rk(int index, CTAP_residentKey * rk)
 {
     if (index < RK_NUM)
     {
-        memmove(RK_STORE.rks + index, rk, sizeof(CTAP_residentKey));
-        sync_rk();
+        memmove(RK_STORE->rks + index, rk, sizeof(CTAP_residentKey));
+        sync_range(RK_STORE->rks + index, sizeof(CTAP_residentKey));
     }
     else
     {
@@ -0,0 +1,149 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+
+// Simulator server hosting several independent authenticators in one process.
+//
+//     ./server [count]
+//
+// Authenticator n runs on its own thread, listens on UDP port 8111+n and
+// keeps its state in its own files.  All firmware state is
+// AUTHENTICATOR_LOCAL, so a thread is the authenticator's context, and a
+// reboot (the magic reboot frame) starts the authenticator on a new thread.
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <signal.h>
+
+#include "cbor.h"
+#include "device.h"
+#include "ctaphid.h"
+#include "util.h"
+#include "log.h"
+#include "ctap.h"
+#include APP_CONFIG
+
+void device_set_instance(int n);
+void device_hosting_init();
+void device_shutdown();
+int device_shutdown_requested();
+int device_reboot_requested();
+void device_close();
+
+// One boot of an authenticator
+// @return nonzero if it should be started again
+static void * authenticator_thread(void * arg)
+{
+    uint8_t hidmsg[64];
+    int reboot;
+
+    device_set_instance((int)(intptr_t)arg);
+    device_init();
+
+    memset(hidmsg,0,sizeof(hidmsg));
+
+    while (!device_shutdown_requested() && !device_reboot_requested())
+    {
+        device_manage();
+
+        if (usbhid_recv(hidmsg) > 0)
+        {
+            ctaphid_handle_packet(hidmsg);
+            memset(hidmsg, 0, sizeof(hidmsg));
+        }
+        else
+        {
+            ctap_idle();
+        }
+        ctaphid_check_timeouts();
+    }
+
+    reboot = device_reboot_requested();
+    device_close();
+    return (void *)(intptr_t)reboot;
+}
+
+static void * instance_thread(void * arg)
+{
+    pthread_t thread;
+    void * reboot;
+
+    do
+    {
+        if (pthread_create(&thread, NULL, authenticator_thread, arg) != 0)
+        {
+            perror("pthread_create");
+            exit(1);
+        }
+        pthread_join(thread, &reboot);
+    }
+    while (reboot != NULL && !device_shutdown_requested());
+
+    return NULL;
+}
+
+int main(int argc, char * argv[])
+{
+    int count = 1;
+    int i, sig;
+    pthread_t * threads;
+    sigset_t sigint;
+
+    if (argc > 1)
+    {
+        count = atoi(argv[1]);
+    }
+    if (count < 1)
+    {
+        printf("usage: %s [count]\n", argv[0]);
+        return 1;
+    }
+
+    set_logging_mask(
+		TAG_GREEN|
+		TAG_RED|
+		TAG_ERR
+	);
+
+    threads = malloc(sizeof(pthread_t) * count);
+    if (threads == NULL)
+    {
+        perror("malloc");
+        return 1;
+    }
+
+    // SIGINT is only taken here.  The threads inherit the blocked mask.
+    sigemptyset(&sigint);
+    sigaddset(&sigint, SIGINT);
+    pthread_sigmask(SIG_BLOCK, &sigint, NULL);
+
+    device_hosting_init();
+
+    for (i = 0; i < count; i++)
+    {
+        if (pthread_create(threads + i, NULL, instance_thread, (void *)(intptr_t)i) != 0)
+        {
+            perror("pthread_create");
+            return 1;
+        }
+    }
+    printf1(TAG_GREEN, "hosting %d authenticators on ports %d-%d\n", count, 8111, 8111 + count - 1);
+
+    sigwait(&sigint, &sig);
+
+    // Every instance flushes and closes its own socket on the way out
+    device_shutdown();
+    for (i = 0; i < count; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    printf("SIGINT... exiting.\n");
+
+    free(threads);
+    return 0;
+}
@@ -1,7 +1,7 @@
 include build/common.mk
 
 # ST related
-SRC = src/main.c src/init.c src/redirect.c src/flash.c src/rng.c src/led.c src/device.c
+SRC = src/main.c src/init.c src/redirect.c src/flash.c src/rng.c src/led.c src/device.c src/rk_store.c src/counter.c src/state.c
 SRC += src/fifo.c src/crypto.c src/attestation.c src/nfc.c src/ams.c
 SRC += src/startup_stm32l432xx.s src/system_stm32l4xx.c
 SRC += $(DRIVER_LIBS) $(USB_LIB)
@@ -15,6 +15,8 @@ SRC += ../../fido2/extensions/extensions.c ../../fido2/extensions/solo.c
 # Crypto libs
 SRC += ../../crypto/sha256/sha256.c ../../crypto/micro-ecc/uECC.c ../../crypto/tiny-AES-c/aes.c
 SRC += ../../crypto/cifra/src/sha512.c ../../crypto/cifra/src/blockwise.c
+SRC += ../../crypto/p256/p256.c ../../crypto/p256/p256_field.c ../../crypto/p256/p256_rfc6979.c
+SRC += ../../crypto/aes-gcm/aes_gcm.c
 
 OBJ1=$(SRC:.c=.o)
 OBJ=$(OBJ1:.s=.o)
@@ -23,6 +25,7 @@ INC = -Isrc/ -Isrc/cmsis/ -Ilib/ -Ilib/usbd/ -I../../fido2/ -I../../fido2/extens
 INC += -I../../tinycbor/src -I../../crypto/sha256 -I../../crypto/micro-ecc
 INC += -I../../crypto/tiny-AES-c
 INC += -I../../crypto/cifra/src -I../../crypto/cifra/src/ext
+INC += -I../../crypto/p256 -I../../crypto/aes-gcm
 
 SEARCH=-L../../tinycbor/lib
 
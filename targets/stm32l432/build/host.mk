@@ -0,0 +1,37 @@
+# Builds the storage code for the host against the flash emulator in tests/
+
+CC=gcc
+
+INC = -Isrc/ -Itests/ -I../../fido2/ -I../../tinycbor/src
+
+DEFINES = -DDEBUG_LEVEL=0 -DAPP_CONFIG=\"app.h\"
+
+CFLAGS = $(INC) $(DEFINES) -O2 -g -Wall -Wextra -Wno-unused-parameter -Wno-int-to-pointer-cast
+
+FLASH_EMU = tests/flash_emu.host.o
+
+.PHONY: all run bench clean
+
+all: test_rk_store test_counter bench_storage
+
+%.host.o: %.c
+	$(CC) -c $^ $(CFLAGS) -o $@
+
+test_rk_store: tests/test_rk_store.host.o src/rk_store.host.o $(FLASH_EMU)
+	$(CC) $^ -o $@
+
+test_counter: tests/test_counter.host.o src/counter.host.o $(FLASH_EMU)
+	$(CC) $^ -o $@
+
+bench_storage: tests/bench_storage.host.o src/counter.host.o src/rk_store.host.o src/state.host.o $(FLASH_EMU)
+	$(CC) $^ -o $@
+
+run: all
+	./test_rk_store
+	./test_counter
+
+bench: bench_storage
+	./bench_storage
+
+clean:
+	rm -f test_rk_store test_counter bench_storage src/*.host.o tests/*.host.o
@@ -26,6 +26,10 @@
 
 #define ENABLE_U2F
 
+// RFC 6979 nonces for ECDSA instead of the TRNG.  Left off on the device: a
+// glitched computation over a repeated nonce can leak the key.
+// #define ENABLE_DETERMINISTIC_ECDSA
+
 // #define DISABLE_CTAPHID_PING
 // #define DISABLE_CTAPHID_WINK
 // #define DISABLE_CTAPHID_CBOR
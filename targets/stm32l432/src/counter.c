@@ -0,0 +1,180 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+
+// Signature counter kept as a tally in COUNTER1_PAGE.
+//
+// The first dword of the page holds the base count (and its complement),
+// every other dword adds up to two counts: it is programmed with a mark for
+// the first and cleared to zero for the second.  Flash ECC on the L4 only
+// allows a programmed dword to be written again with zeros, so this is as
+// dense as a tally can get.  The count is base + marks + 2 * zeros, and the
+// position of the next tally dword is cached in RAM after boot.
+//
+// COUNTER2_PAGE holds the epoch E (and its complement).  A page started in
+// epoch E has base E * COUNTER_PERIOD, which is above every count of the
+// epochs before it.  The epoch is always advanced before COUNTER1_PAGE is
+// erased, so after a power loss the counter restarts from a fresh page in
+// the current epoch and never goes down.
+#include <stdint.h>
+#include <string.h>
+
+#include APP_CONFIG
+#include "flash.h"
+#include "memory_layout.h"
+#include "counter.h"
+#include "log.h"
+
+#define COUNTER_DWORDS      (PAGE_SIZE / 8)
+#define COUNTER_PERIOD      512         // more than the counts that fit in a page
+#define COUNTER_MARK        0x5aa55aa55aa55aa5ULL
+
+// Counts per erase in the format used before the tally
+#define COUNTER_OLD_PERIOD  256
+
+static uint32_t counter_value;
+static int counter_pos;                 // tally dword being filled
+static int counter_half;                // that dword holds the mark
+
+static uint32_t * counter_dword(int page, int i)
+{
+    return (uint32_t *)(uintptr_t)flash_addr(page) + i * 2;
+}
+
+static int is_erased(uint32_t * dword)
+{
+    return dword[0] == 0xffffffff && dword[1] == 0xffffffff;
+}
+
+static int is_valid(uint32_t * dword)
+{
+    return dword[1] == ~dword[0];
+}
+
+static void counter_write_epoch(uint32_t epoch)
+{
+    uint32_t dword[2] = {epoch, ~epoch};
+    flash_erase_page(COUNTER2_PAGE);
+    flash_write(flash_addr(COUNTER2_PAGE), (uint8_t*)dword, 8);
+}
+
+static void counter_start_page(uint32_t epoch)
+{
+    uint32_t dword[2] = {epoch * COUNTER_PERIOD, ~(epoch * COUNTER_PERIOD)};
+    flash_erase_page(COUNTER1_PAGE);
+    flash_write(flash_addr(COUNTER1_PAGE), (uint8_t*)dword, 8);
+    counter_value = dword[0];
+    counter_pos = 1;
+    counter_half = 0;
+}
+
+// Epoch to continue from when COUNTER2_PAGE doesn't hold a valid one
+static uint32_t counter_recover_epoch()
+{
+    uint32_t * epoch = counter_dword(COUNTER2_PAGE, 0);
+    uint32_t * ptr = counter_dword(COUNTER1_PAGE, 0);
+    uint32_t bound;
+    int offset;
+
+    if (epoch[0] != 0xffffffff && epoch[1] == 0xffffffff)
+    {
+        // Written by firmware before the tally, where the page held the
+        // count in every other word and COUNTER2_PAGE the number of erases.
+        bound = (epoch[0] + 1) * COUNTER_OLD_PERIOD;
+        for (offset = 0; offset < PAGE_SIZE/4; offset += 2)
+        {
+            if (ptr[offset] != 0xffffffff && ptr[offset] > bound)
+            {
+                bound = ptr[offset];
+            }
+        }
+        printf1(TAG_GREEN, "converting counter, last count <= %lu\r\n", bound);
+        return bound / COUNTER_PERIOD + 1;
+    }
+    if (is_valid(ptr) && ptr[0] % COUNTER_PERIOD == 0)
+    {
+        // Power interrupted while advancing the epoch
+        printf2(TAG_ERR, "warning, power interrupted, restoring counter epoch\r\n");
+        return ptr[0] / COUNTER_PERIOD + 1;
+    }
+    return 1;
+}
+
+void counter_init()
+{
+    uint32_t * epoch_dword = counter_dword(COUNTER2_PAGE, 0);
+    uint32_t * base = counter_dword(COUNTER1_PAGE, 0);
+    uint32_t epoch;
+    int i;
+
+    if (is_valid(epoch_dword))
+    {
+        epoch = epoch_dword[0];
+    }
+    else
+    {
+        epoch = counter_recover_epoch();
+        counter_write_epoch(epoch);
+    }
+
+    if (!is_valid(base) || base[0] != epoch * COUNTER_PERIOD)
+    {
+        if (is_valid(base) && base[0] % COUNTER_PERIOD == 0 && base[0] > epoch * COUNTER_PERIOD)
+        {
+            epoch = base[0] / COUNTER_PERIOD + 1;
+            counter_write_epoch(epoch);
+        }
+        printf2(TAG_ERR, "warning, power interrupted during previous count.  Restoring. epoch=%lu\r\n", epoch);
+        counter_start_page(epoch);
+        return;
+    }
+
+    for (i = 1; i < COUNTER_DWORDS; i++)
+    {
+        uint32_t * dword = counter_dword(COUNTER1_PAGE, i);
+        if (dword[0] != 0 || dword[1] != 0)
+        {
+            break;
+        }
+    }
+    counter_pos = i;
+    counter_half = (i < COUNTER_DWORDS) && !is_erased(counter_dword(COUNTER1_PAGE, i));
+    counter_value = base[0] + 2 * (counter_pos - 1) + counter_half;
+}
+
+uint32_t counter_increment()
+{
+    uint32_t epoch;
+    uint64_t data;
+    uint32_t addr;
+
+    if (counter_pos == COUNTER_DWORDS)
+    {
+        epoch = counter_value / COUNTER_PERIOD + 1;
+        counter_write_epoch(epoch);
+        counter_start_page(epoch);
+    }
+
+    addr = flash_addr(COUNTER1_PAGE) + counter_pos * 8;
+    data = counter_half ? 0 : COUNTER_MARK;
+    flash_write(addr, (uint8_t*)&data, 8);
+
+    if (memcmp((uint8_t *)(uintptr_t)addr, &data, 8) != 0)
+    {
+        printf1(TAG_RED,"no count detected:  count==%lu, pos=%d\r\n", counter_value, counter_pos);
+        while(1)
+            ;
+    }
+
+    if (counter_half)
+    {
+        counter_pos++;
+    }
+    counter_half = !counter_half;
+    counter_value++;
+
+    return counter_value;
+}
@@ -0,0 +1,20 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+#ifndef _COUNTER_H_
+#define _COUNTER_H_
+
+#include <stdint.h>
+
+// Scan the counter pages and cache the position of the count in RAM,
+// repairing them after a power loss.  Must be called once at boot.
+void counter_init();
+
+// Increment the signature counter and return the new value.  Never returns
+// a value twice, even across power loss.
+uint32_t counter_increment();
+
+#endif
@@ -21,6 +21,7 @@
 
 #include "sha256.h"
 #include "uECC.h"
+#include "p256.h"
 #include "aes.h"
 #include "ctap.h"
 #include "device.h"
@@ -60,10 +61,55 @@ static int _key_len = 0;
 static uint8_t master_secret[64];
 static uint8_t transport_secret[32];
 
+// HMAC midstates of the long-lived secrets, {inner, outer}.  Filled in
+// whenever the secrets are loaded or reset.
+static SHA256_CTX master_hmac_ctx[2];
+static SHA256_CTX transport_hmac_ctx[2];
+// AES round keys of the transport key and the key wrapping key in the
+// upper half of master_secret, copied instead of expanded again
+static crypto_aes_ctx transport_aes_ctx;
+static crypto_aes_ctx master_aes_ctx;
+
 
 void crypto_sha256_init()
 {
-    sha256_init(&sha256_ctx);
+    crypto_sha256_ctx_init(&sha256_ctx);
+}
+
+// Hash the key padded with @pad into @ctx
+static void hmac_midstate(SHA256_CTX * ctx, uint8_t * key, uint32_t klen, uint8_t pad)
+{
+    uint8_t buf[64];
+    unsigned int i;
+
+    if(klen > 64)
+    {
+        printf2(TAG_ERR, "Error, key size must be <= 64\n");
+        exit(1);
+    }
+
+    memset(buf, 0, sizeof(buf));
+    memmove(buf, key, klen);
+
+    for (i = 0; i < sizeof(buf); i++)
+    {
+        buf[i] = buf[i] ^ pad;
+    }
+
+    sha256_init(ctx);
+    sha256_update(ctx, buf, 64);
+}
+
+static void crypto_key_precompute()
+{
+    hmac_midstate(&master_hmac_ctx[0], master_secret, sizeof(master_secret)/2, 0x36);
+    hmac_midstate(&master_hmac_ctx[1], master_secret, sizeof(master_secret)/2, 0x5c);
+    hmac_midstate(&transport_hmac_ctx[0], transport_secret, 32, 0x36);
+    // The outer pad of the transport key has always been keyed with zeros.
+    // Credential tags depend on it, so it has to stay that way.
+    hmac_midstate(&transport_hmac_ctx[1], transport_secret, 0, 0x5c);
+    AES_init_ctx(&transport_aes_ctx, transport_secret);
+    AES_init_ctx(&master_aes_ctx, master_secret + 32);
 }
 
 void crypto_sha512_init() {
@@ -77,6 +123,7 @@ void crypto_load_master_secret(uint8_t * key)
 #endif
     memmove(master_secret, key, 64);
     memmove(transport_secret, key+64, 32);
+    crypto_key_precompute();
 }
 
 void crypto_reset_master_secret()
@@ -85,98 +132,173 @@ void crypto_reset_master_secret()
     memset(transport_secret, 0, 32);
     ctap_generate_rng(master_secret, 64);
     ctap_generate_rng(transport_secret, 32);
+    crypto_key_precompute();
 }
 
-
-void crypto_sha256_update(uint8_t * data, size_t len)
+void crypto_sha256_ctx_init(SHA256_CTX * ctx)
 {
-    sha256_update(&sha256_ctx, data, len);
+    sha256_init(ctx);
 }
 
-void crypto_sha512_update(const uint8_t * data, size_t len) {
-    cf_sha512_update(&sha512_ctx, data, len);
-}
-
-void crypto_sha256_update_secret()
+void crypto_sha256_ctx_update(SHA256_CTX * ctx, const uint8_t * data, size_t len)
 {
-    sha256_update(&sha256_ctx, master_secret, 32);
+    sha256_update(ctx, data, len);
 }
 
-void crypto_sha256_final(uint8_t * hash)
+void crypto_sha256_ctx_final(SHA256_CTX * ctx, uint8_t * hash)
 {
-    sha256_final(&sha256_ctx, hash);
+    sha256_final(ctx, hash);
 }
 
-void crypto_sha512_final(uint8_t * hash) {
-    // NB: there is also cf_sha512_digest
-    cf_sha512_digest_final(&sha512_ctx, hash);
+void crypto_hmac_ctx_init(SHA256_CTX * ctx, uint8_t * key, uint32_t klen)
+{
+    if (key == CRYPTO_MASTER_KEY)
+    {
+        *ctx = master_hmac_ctx[0];
+    }
+    else if (key == CRYPTO_TRANSPORT_KEY)
+    {
+        *ctx = transport_hmac_ctx[0];
+    }
+    else
+    {
+        hmac_midstate(ctx, key, klen, 0x36);
+    }
 }
 
-void crypto_sha256_hmac_init(uint8_t * key, uint32_t klen, uint8_t * hmac)
+void crypto_hmac_ctx_final(SHA256_CTX * ctx, uint8_t * key, uint32_t klen, uint8_t * hmac)
 {
-    uint8_t buf[64];
-    unsigned int i;
-    memset(buf, 0, sizeof(buf));
+    sha256_final(ctx, hmac);
 
     if (key == CRYPTO_MASTER_KEY)
     {
-        key = master_secret;
-        klen = sizeof(master_secret)/2;
+        *ctx = master_hmac_ctx[1];
     }
     else if (key == CRYPTO_TRANSPORT_KEY)
     {
-        key = transport_secret;
-        klen = 32;
+        *ctx = transport_hmac_ctx[1];
     }
-
-    if(klen > 64)
+    else
     {
-        printf2(TAG_ERR, "Error, key size must be <= 64\n");
-        exit(1);
+        hmac_midstate(ctx, key, klen, 0x5c);
     }
 
-    memmove(buf, key, klen);
+    sha256_update(ctx, hmac, 32);
+    sha256_final(ctx, hmac);
+}
 
-    for (i = 0; i < sizeof(buf); i++)
+#define HMAC_BATCH_LANES    8
+
+// Pad the one block message of @len bytes in @block, counting the key pad
+// that was hashed before it.
+static void hmac_pad_block(uint8_t * block, uint32_t len)
+{
+    uint64_t bits = (64 + len) * 8;
+    int i;
+
+    block[len] = 0x80;
+    memset(block + len + 1, 0, 64 - 8 - len - 1);
+    for (i = 0; i < 8; i++)
     {
-        buf[i] = buf[i] ^ 0x36;
+        block[63 - i] = bits >> (i * 8);
     }
-
-    crypto_sha256_init();
-    crypto_sha256_update(buf, 64);
 }
 
-void crypto_sha256_hmac_final(uint8_t * key, uint32_t klen, uint8_t * hmac)
+static void hmac_state_bytes(WORD * state, uint8_t * hash)
 {
-    uint8_t buf[64];
-    unsigned int i;
-    crypto_sha256_final(hmac);
-    memset(buf, 0, sizeof(buf));
-    if (key == CRYPTO_MASTER_KEY)
+    int i;
+    for (i = 0; i < 8; i++)
     {
-        key = master_secret;
-        klen = sizeof(master_secret)/2;
+        hash[i * 4 + 0] = state[i] >> 24;
+        hash[i * 4 + 1] = state[i] >> 16;
+        hash[i * 4 + 2] = state[i] >> 8;
+        hash[i * 4 + 3] = state[i];
     }
+}
 
-
-    if(klen > 64)
+void crypto_hmac_batch(uint8_t * key, uint32_t klen, uint8_t * msgs, uint32_t len, int n, uint8_t (*hmacs)[32])
+{
+    WORD state[HMAC_BATCH_LANES][8];
+    BYTE block[HMAC_BATCH_LANES][64];
+    SHA256_CTX * pads;
+    SHA256_CTX ctx;
+    int i, j, lanes;
+
+    // Messages that don't fit in one block, and other keys, take the long way
+    if (len > 64 - 8 - 1 || (key != CRYPTO_MASTER_KEY && key != CRYPTO_TRANSPORT_KEY))
     {
-        printf2(TAG_ERR, "Error, key size must be <= 64\n");
-        exit(1);
+        for (i = 0; i < n; i++)
+        {
+            crypto_hmac_ctx_init(&ctx, key, klen);
+            crypto_sha256_ctx_update(&ctx, msgs + i * len, len);
+            crypto_hmac_ctx_final(&ctx, key, klen, hmacs[i]);
+        }
+        return;
     }
-    memmove(buf, key, klen);
 
-    for (i = 0; i < sizeof(buf); i++)
+    pads = (key == CRYPTO_MASTER_KEY) ? master_hmac_ctx : transport_hmac_ctx;
+
+    for (i = 0; i < n; i += lanes)
     {
-        buf[i] = buf[i] ^ 0x5c;
+        lanes = (n - i < HMAC_BATCH_LANES) ? n - i : HMAC_BATCH_LANES;
+
+        for (j = 0; j < lanes; j++)
+        {
+            memmove(state[j], pads[0].state, sizeof(state[j]));
+            memmove(block[j], msgs + (i + j) * len, len);
+            hmac_pad_block(block[j], len);
+        }
+        sha256_transform_lanes(state, (const BYTE (*)[64])block, lanes);
+
+        for (j = 0; j < lanes; j++)
+        {
+            hmac_state_bytes(state[j], block[j]);
+            hmac_pad_block(block[j], 32);
+            memmove(state[j], pads[1].state, sizeof(state[j]));
+        }
+        sha256_transform_lanes(state, (const BYTE (*)[64])block, lanes);
+
+        for (j = 0; j < lanes; j++)
+        {
+            hmac_state_bytes(state[j], hmacs[i + j]);
+        }
     }
+}
 
-    crypto_sha256_init();
-    crypto_sha256_update(buf, 64);
-    crypto_sha256_update(hmac, 32);
-    crypto_sha256_final(hmac);
+
+void crypto_sha256_update(uint8_t * data, size_t len)
+{
+    crypto_sha256_ctx_update(&sha256_ctx, data, len);
 }
 
+void crypto_sha512_update(const uint8_t * data, size_t len) {
+    cf_sha512_update(&sha512_ctx, data, len);
+}
+
+void crypto_sha256_update_secret()
+{
+    crypto_sha256_ctx_update(&sha256_ctx, master_secret, 32);
+}
+
+void crypto_sha256_final(uint8_t * hash)
+{
+    crypto_sha256_ctx_final(&sha256_ctx, hash);
+}
+
+void crypto_sha512_final(uint8_t * hash) {
+    // NB: there is also cf_sha512_digest
+    cf_sha512_digest_final(&sha512_ctx, hash);
+}
+
+void crypto_sha256_hmac_init(uint8_t * key, uint32_t klen, uint8_t * hmac)
+{
+    crypto_hmac_ctx_init(&sha256_ctx, key, klen);
+}
+
+void crypto_sha256_hmac_final(uint8_t * key, uint32_t klen, uint8_t * hmac)
+{
+    crypto_hmac_ctx_final(&sha256_ctx, key, klen, hmac);
+}
 
 void crypto_ecc256_init()
 {
@@ -193,13 +315,59 @@ void crypto_ecc256_load_attestation_key()
     _key_len = 32;
 }
 
-void crypto_ecc256_sign(uint8_t * data, int len, uint8_t * sig)
+#ifdef ENABLE_DETERMINISTIC_ECDSA
+// SHA-256 for micro-ecc's RFC 6979 nonces on the other curves
+typedef struct
+{
+    uECC_HashContext uECC;
+    SHA256_CTX ctx;
+} uECC_SHA256_HashContext;
+
+static void uecc_sha256_init(const uECC_HashContext * base)
+{
+    uECC_SHA256_HashContext * context = (uECC_SHA256_HashContext *)base;
+    sha256_init(&context->ctx);
+}
+
+static void uecc_sha256_update(const uECC_HashContext * base, const uint8_t * message, unsigned message_size)
+{
+    uECC_SHA256_HashContext * context = (uECC_SHA256_HashContext *)base;
+    sha256_update(&context->ctx, message, message_size);
+}
+
+static void uecc_sha256_finish(const uECC_HashContext * base, uint8_t * hash_result)
+{
+    uECC_SHA256_HashContext * context = (uECC_SHA256_HashContext *)base;
+    sha256_final(&context->ctx, hash_result);
+}
+#endif
+
+void crypto_ecc256_sign_with_key(const uint8_t * key, uint8_t * data, int len, uint8_t * sig)
 {
-    if ( uECC_sign(_signing_key, data, len, sig, _es256_curve) == 0)
+#ifdef ENABLE_DETERMINISTIC_ECDSA
+    // The nonce comes from the key and hash (RFC 6979), not the RNG
+    if ( ! p256_sign_deterministic(key, data, len, sig))
     {
-        printf2(TAG_ERR, "error, uECC failed\n");
+        printf2(TAG_ERR, "error, invalid P-256 key\n");
         exit(1);
     }
+#else
+    uint8_t k[32];
+
+    // Draw nonces until one is in range
+    do
+    {
+        ctap_generate_rng(k, 32);
+    }
+    while ( ! p256_sign(key, data, len, k, sig));
+
+    memset(k, 0, sizeof(k));
+#endif
+}
+
+void crypto_ecc256_sign(uint8_t * data, int len, uint8_t * sig)
+{
+    crypto_ecc256_sign_with_key(_signing_key, data, len, sig);
 }
 
 void crypto_ecc256_load_key(uint8_t * data, int len, uint8_t * data2, int len2)
@@ -210,35 +378,45 @@ void crypto_ecc256_load_key(uint8_t * data, int len, uint8_t * data2, int len2)
     _key_len = 32;
 }
 
-void crypto_ecdsa_sign(uint8_t * data, int len, uint8_t * sig, int MBEDTLS_ECP_ID)
+void crypto_ecdsa_sign_with_key(const uint8_t * key, int key_len, uint8_t * data, int len, uint8_t * sig, int MBEDTLS_ECP_ID)
 {
 
     const struct uECC_Curve_t * curve = NULL;
+#ifdef ENABLE_DETERMINISTIC_ECDSA
+    uint8_t tmp[2 * 32 + 64];
+    uECC_SHA256_HashContext hash_context = {
+        .uECC = { &uecc_sha256_init, &uecc_sha256_update, &uecc_sha256_finish, 64, 32, tmp }
+    };
+#endif
 
     switch(MBEDTLS_ECP_ID)
     {
         case MBEDTLS_ECP_DP_SECP192R1:
             curve = uECC_secp192r1();
-            if (_key_len != 24)  goto fail;
+            if (key_len != 24)  goto fail;
             break;
         case MBEDTLS_ECP_DP_SECP224R1:
             curve = uECC_secp224r1();
-            if (_key_len != 28)  goto fail;
+            if (key_len != 28)  goto fail;
             break;
         case MBEDTLS_ECP_DP_SECP256R1:
-            curve = uECC_secp256r1();
-            if (_key_len != 32)  goto fail;
-            break;
+            if (key_len != 32)  goto fail;
+            crypto_ecc256_sign_with_key(key, data, len, sig);
+            return;
         case MBEDTLS_ECP_DP_SECP256K1:
             curve = uECC_secp256k1();
-            if (_key_len != 32)  goto fail;
+            if (key_len != 32)  goto fail;
             break;
         default:
             printf2(TAG_ERR, "error, invalid ECDSA alg specifier\n");
             exit(1);
     }
 
-    if ( uECC_sign(_signing_key, data, len, sig, curve) == 0)
+#ifdef ENABLE_DETERMINISTIC_ECDSA
+    if ( uECC_sign_deterministic(key, data, len, &hash_context.uECC, sig, curve) == 0)
+#else
+    if ( uECC_sign(key, data, len, sig, curve) == 0)
+#endif
     {
         printf2(TAG_ERR, "error, uECC failed\n");
         exit(1);
@@ -251,16 +429,25 @@ fail:
 
 }
 
-void generate_private_key(uint8_t * data, int len, uint8_t * data2, int len2, uint8_t * privkey)
+void crypto_ecdsa_sign(uint8_t * data, int len, uint8_t * sig, int MBEDTLS_ECP_ID)
 {
-    crypto_sha256_hmac_init(CRYPTO_MASTER_KEY, 0, privkey);
-    crypto_sha256_update(data, len);
-    crypto_sha256_update(data2, len2);
-    crypto_sha256_update(master_secret, 32);    // TODO AES
-    crypto_sha256_hmac_final(CRYPTO_MASTER_KEY, 0, privkey);
+    crypto_ecdsa_sign_with_key(_signing_key, _key_len, data, len, sig, MBEDTLS_ECP_ID);
+}
 
-    crypto_aes256_init(master_secret + 32, NULL);
-    crypto_aes256_encrypt(privkey, 32);
+void generate_private_key(uint8_t * data, int len, uint8_t * data2, int len2, uint8_t * privkey)
+{
+    SHA256_CTX ctx;
+    crypto_aes_ctx aes;
+
+    crypto_hmac_ctx_init(&ctx, CRYPTO_MASTER_KEY, 0);
+    crypto_sha256_ctx_update(&ctx, data, len);
+    crypto_sha256_ctx_update(&ctx, data2, len2);
+    crypto_sha256_ctx_update(&ctx, master_secret, 32);    // TODO AES
+    crypto_hmac_ctx_final(&ctx, CRYPTO_MASTER_KEY, 0, privkey);
+
+    aes = master_aes_ctx;
+    crypto_aes_ctx_reset_iv(&aes, NULL);
+    crypto_aes_ctx_encrypt(&aes, privkey, 32);
 }
 
 
@@ -273,7 +460,7 @@ void crypto_ecc256_derive_public_key(uint8_t * data, int len, uint8_t * x, uint8
     generate_private_key(data,len,NULL,0,privkey);
 
     memset(pubkey,0,sizeof(pubkey));
-    uECC_compute_public_key(privkey, pubkey, _es256_curve);
+    p256_base_mult(privkey, pubkey);
     memmove(x,pubkey,32);
     memmove(y,pubkey+32,32);
 }
@@ -287,11 +474,11 @@ void crypto_load_external_key(uint8_t * key, int len)
 
 void crypto_ecc256_make_key_pair(uint8_t * pubkey, uint8_t * privkey)
 {
-    if (uECC_make_key(pubkey, privkey, _es256_curve) != 1)
+    do
     {
-        printf2(TAG_ERR, "Error, uECC_make_key failed\n");
-        exit(1);
+        ctap_generate_rng(privkey, 32);
     }
+    while ( ! p256_base_mult(privkey, pubkey));
 }
 
 void crypto_ecc256_shared_secret(const uint8_t * pubkey, const uint8_t * privkey, uint8_t * shared_secret)
@@ -304,48 +491,61 @@ void crypto_ecc256_shared_secret(const uint8_t * pubkey, const uint8_t * privkey
 
 }
 
-struct AES_ctx aes_ctx;
-void crypto_aes256_init(uint8_t * key, uint8_t * nonce)
+void crypto_aes_ctx_init(crypto_aes_ctx * ctx, uint8_t * key, uint8_t * nonce)
 {
     if (key == CRYPTO_TRANSPORT_KEY)
     {
-        AES_init_ctx(&aes_ctx, transport_secret);
+        *ctx = transport_aes_ctx;
     }
     else
     {
-        AES_init_ctx(&aes_ctx, key);
-    }
-    if (nonce == NULL)
-    {
-        memset(aes_ctx.Iv, 0, 16);
-    }
-    else
-    {
-        memmove(aes_ctx.Iv, nonce, 16);
+        AES_init_ctx(ctx, key);
     }
+    crypto_aes_ctx_reset_iv(ctx, nonce);
 }
 
 // prevent round key recomputation
-void crypto_aes256_reset_iv(uint8_t * nonce)
+void crypto_aes_ctx_reset_iv(crypto_aes_ctx * ctx, uint8_t * nonce)
 {
     if (nonce == NULL)
     {
-        memset(aes_ctx.Iv, 0, 16);
+        memset(ctx->Iv, 0, 16);
     }
     else
     {
-        memmove(aes_ctx.Iv, nonce, 16);
+        memmove(ctx->Iv, nonce, 16);
     }
 }
 
+void crypto_aes_ctx_decrypt(crypto_aes_ctx * ctx, uint8_t * buf, int length)
+{
+    AES_CBC_decrypt_buffer(ctx, buf, length);
+}
+
+void crypto_aes_ctx_encrypt(crypto_aes_ctx * ctx, uint8_t * buf, int length)
+{
+    AES_CBC_encrypt_buffer(ctx, buf, length);
+}
+
+crypto_aes_ctx aes_ctx;
+void crypto_aes256_init(uint8_t * key, uint8_t * nonce)
+{
+    crypto_aes_ctx_init(&aes_ctx, key, nonce);
+}
+
+void crypto_aes256_reset_iv(uint8_t * nonce)
+{
+    crypto_aes_ctx_reset_iv(&aes_ctx, nonce);
+}
+
 void crypto_aes256_decrypt(uint8_t * buf, int length)
 {
-    AES_CBC_decrypt_buffer(&aes_ctx, buf, length);
+    crypto_aes_ctx_decrypt(&aes_ctx, buf, length);
 }
 
 void crypto_aes256_encrypt(uint8_t * buf, int length)
 {
-    AES_CBC_encrypt_buffer(&aes_ctx, buf, length);
+    crypto_aes_ctx_encrypt(&aes_ctx, buf, length);
 }
 
 
@@ -25,6 +25,8 @@
 #include "ctap.h"
 #include "crypto.h"
 #include "memory_layout.h"
+#include "rk_store.h"
+#include "counter.h"
 #include "stm32l4xx_ll_iwdg.h"
 #include "usbd_cdc_if.h"
 #include "nfc.h"
@@ -128,6 +130,8 @@ void device_init()
 
     usbhid_init();
     ctaphid_init();
+    rk_store_init();
+    counter_init();
     ctap_init();
 
 #if BOOT_TO_DFU
@@ -282,132 +286,14 @@ void heartbeat()
 
 }
 
-void authenticator_read_state(AuthenticatorState * a)
-{
-    uint32_t * ptr = (uint32_t *)flash_addr(STATE1_PAGE);
-    memmove(a,ptr,sizeof(AuthenticatorState));
-}
-
-void authenticator_read_backup_state(AuthenticatorState * a)
-{
-    uint32_t * ptr = (uint32_t *)flash_addr(STATE2_PAGE);
-    memmove(a,ptr,sizeof(AuthenticatorState));
-}
-
-// Return 1 yes backup is init'd, else 0
-int authenticator_is_backup_initialized()
-{
-    uint8_t header[16];
-    uint32_t * ptr = (uint32_t *)flash_addr(STATE2_PAGE);
-    memmove(header,ptr,16);
-    AuthenticatorState * state = (AuthenticatorState*)header;
-    return state->is_initialized == INITIALIZED_MARKER;
-}
-
-void authenticator_write_state(AuthenticatorState * a, int backup)
-{
-    if (! backup)
-    {
-        flash_erase_page(STATE1_PAGE);
-
-        flash_write(flash_addr(STATE1_PAGE), (uint8_t*)a, sizeof(AuthenticatorState));
-    }
-    else
-    {
-        flash_erase_page(STATE2_PAGE);
-
-        flash_write(flash_addr(STATE2_PAGE), (uint8_t*)a, sizeof(AuthenticatorState));
-    }
-}
-
 uint32_t ctap_atomic_count(int sel)
 {
-    int offset = 0;
-    uint32_t * ptr = (uint32_t *)flash_addr(COUNTER1_PAGE);
-    uint32_t erases = *(uint32_t *)flash_addr(COUNTER2_PAGE);
-    static uint32_t sc = 0;
-    if (erases == 0xffffffff)
-    {
-        erases = 1;
-        flash_erase_page(COUNTER2_PAGE);
-        flash_write(flash_addr(COUNTER2_PAGE), (uint8_t*)&erases, 4);
-    }
-
-    uint32_t lastc = 0;
-
     if (sel != 0)
     {
         printf2(TAG_ERR,"counter2 not imple\n");
         exit(1);
     }
-
-    for (offset = 0; offset < PAGE_SIZE/4; offset += 2) // wear-level the flash
-    {
-        if (ptr[offset] != 0xffffffff)
-        {
-            if (ptr[offset] < lastc)
-            {
-                printf2(TAG_ERR,"Error, count went down!\r\n");
-            }
-            lastc = ptr[offset];
-        }
-        else
-        {
-            break;
-        }
-    }
-
-    if (!lastc) // Happens on initialization as well.
-    {
-        printf2(TAG_ERR,"warning, power interrupted during previous count.  Restoring. lastc==%lu, erases=%lu, offset=%d\r\n", lastc,erases,offset);
-        // there are 32 counts per page
-        lastc =  erases * 256 + 1;
-        flash_erase_page(COUNTER1_PAGE);
-        flash_write(flash_addr(COUNTER1_PAGE), (uint8_t*)&lastc, 4);
-
-        erases++;
-        flash_erase_page(COUNTER2_PAGE);
-        flash_write(flash_addr(COUNTER2_PAGE), (uint8_t*)&erases, 4);
-        return lastc;
-    }
-
-    lastc++;
-
-    if (lastc/256 > erases)
-    {
-        printf2(TAG_ERR,"warning, power interrupted, erases mark, restoring. lastc==%lu, erases=%lu\r\n", lastc,erases);
-        erases = lastc/256;
-        flash_erase_page(COUNTER2_PAGE);
-        flash_write(flash_addr(COUNTER2_PAGE), (uint8_t*)&erases, 4);
-    }
-
-    if (offset == PAGE_SIZE/4)
-    {
-        if (lastc/256 > erases)
-        {
-            printf2(TAG_ERR,"warning, power interrupted, erases mark, restoring lastc==%lu, erases=%lu\r\n", lastc,erases);
-        }
-        erases = lastc/256 + 1;
-        flash_erase_page(COUNTER2_PAGE);
-        flash_write(flash_addr(COUNTER2_PAGE), (uint8_t*)&erases, 4);
-
-        flash_erase_page(COUNTER1_PAGE);
-        offset = 0;
-    }
-
-
-    flash_write(flash_addr(COUNTER1_PAGE) + offset * 4, (uint8_t*)&lastc, 4);
-
-    if (lastc == sc)
-    {
-        printf1(TAG_RED,"no count detected:  lastc==%lu, erases=%lu, offset=%d\r\n", lastc,erases,offset);
-        while(1)
-            ;
-    }
-
-    sc = lastc;
-
-    return lastc;
+    return counter_increment();
 }
 
 
@@ -531,73 +417,35 @@ int ctap_user_verification(uint8_t arg)
 
 void ctap_reset_rk()
 {
-    int i;
-    printf1(TAG_GREEN, "resetting RK \r\n");
-    for(i = 0; i < RK_NUM_PAGES; i++)
-    {
-        flash_erase_page(RK_START_PAGE + i);
-    }
+    rk_store_reset();
 }
 
 uint32_t ctap_rk_size()
 {
-    return RK_NUM_PAGES * (PAGE_SIZE / sizeof(CTAP_residentKey));
+    return rk_store_size();
 }
 
 void ctap_store_rk(int index,CTAP_residentKey * rk)
 {
-    int page_offset = (sizeof(CTAP_residentKey) * index) / PAGE_SIZE;
-    uint32_t addr = flash_addr(page_offset + RK_START_PAGE) + ((sizeof(CTAP_residentKey)*index) % PAGE_SIZE);
-
-    printf1(TAG_GREEN, "storing RK %d @ %04x\r\n", index,addr);
-
-    if (page_offset < RK_NUM_PAGES)
+    printf1(TAG_GREEN, "storing RK %d\r\n", index);
+    if (rk_store_write(index, rk) != 0)
     {
-        flash_write(addr, (uint8_t*)rk, sizeof(CTAP_residentKey));
-        //dump_hex1(TAG_GREEN,rk,sizeof(CTAP_residentKey));
-    }
-    else
-    {
-        printf2(TAG_ERR,"Out of bounds reading index %d for rk\n", index);
+        printf2(TAG_ERR,"Failed storing RK %d\n", index);
     }
 }
 
 void ctap_load_rk(int index,CTAP_residentKey * rk)
 {
-    int page_offset = (sizeof(CTAP_residentKey) * index) / PAGE_SIZE;
-    uint32_t addr = flash_addr(page_offset + RK_START_PAGE) + ((sizeof(CTAP_residentKey)*index) % PAGE_SIZE);
-
-    printf1(TAG_GREEN, "reading RK %d @ %04x\r\n", index, addr);
-    if (page_offset < RK_NUM_PAGES)
-    {
-        uint32_t * ptr = (uint32_t *)addr;
-        memmove((uint8_t*)rk,ptr,sizeof(CTAP_residentKey));
-        //dump_hex1(TAG_GREEN,rk,sizeof(CTAP_residentKey));
-    }
-    else
-    {
-        printf2(TAG_ERR,"Out of bounds reading index %d for rk\n", index);
-    }
+    printf1(TAG_GREEN, "reading RK %d\r\n", index);
+    rk_store_read(index, rk);
 }
 
 void ctap_overwrite_rk(int index,CTAP_residentKey * rk)
 {
-    uint8_t tmppage[PAGE_SIZE];
-    int page_offset = (sizeof(CTAP_residentKey) * index) / PAGE_SIZE;
-    int page = page_offset + RK_START_PAGE;
-
     printf1(TAG_GREEN, "overwriting RK %d\r\n", index);
-    if (page_offset < RK_NUM_PAGES)
-    {
-        memmove(tmppage, (uint8_t*)flash_addr(page), PAGE_SIZE);
-
-        memmove(tmppage + (sizeof(CTAP_residentKey) * index) % PAGE_SIZE, rk, sizeof(CTAP_residentKey));
-        flash_erase_page(page);
-        flash_write(flash_addr(page), tmppage, PAGE_SIZE);
-    }
-    else
+    if (rk_store_write(index, rk) != 0)
     {
-        printf2(TAG_ERR,"Out of bounds reading index %d for rk\n", index);
+        printf2(TAG_ERR,"Failed overwriting RK %d\n", index);
     }
 }
 
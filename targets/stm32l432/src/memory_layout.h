@@ -25,6 +25,11 @@
 #define RK_START_PAGE   (PAGES - 14)
 #define RK_END_PAGE     (PAGES - 14 + RK_NUM_PAGES)     // not included
 
+// Extra pages for the resident key log, taken from the room left after the
+// application.  Lets the log compact without running out of erased pages.
+#define RK_SPARE_PAGES      2
+#define RK_SPARE_START_PAGE (PAGES - 17)
+
 // Start of application code
 #ifndef APPLICATION_START_PAGE
 #define APPLICATION_START_PAGE	(10)
@@ -36,6 +41,7 @@
 #define ATTESTATION_KEY_ADDR    (0x08000000 + ATTESTATION_KEY_PAGE*PAGE_SIZE)
 
 // End of application code.  Leave some extra room for future data storage.
+// Pages 111-112 of that room hold the RK spare pages.
 // NOT included in application
 #define APPLICATION_END_PAGE	((PAGES - 19))
 #define APPLICATION_END_ADDR	((0x08000000 + ((APPLICATION_END_PAGE)*PAGE_SIZE))-8)
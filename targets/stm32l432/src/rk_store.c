@@ -0,0 +1,529 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+
+// Resident keys are kept in an append-only log over the RK pages and the
+// RK spare pages.  Writing or deleting a key appends a record and the newest
+// record for a slot wins, so no page has to be erased to change one key.
+// When the log runs down to its last erased page, the page with the fewest
+// live records is copied forward and erased.
+//
+//  page:    header dword (magic, sequence number), RK_RECORDS_PER_PAGE records
+//  record:  header dword (slot, type, CRC-32), CTAP_residentKey
+//
+// A record header is programmed before its data, so a write cut short by
+// power loss leaves a record that fails its CRC and is skipped.
+#include <stdint.h>
+#include <string.h>
+
+#include APP_CONFIG
+#include "flash.h"
+#include "memory_layout.h"
+#include "rk_store.h"
+#include "log.h"
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t seq;
+} RK_PAGE_HEADER;
+
+typedef struct
+{
+    uint16_t slot;
+    uint8_t type;
+    uint8_t reserved;
+    uint32_t crc;
+} RK_RECORD_HEADER;
+
+#define RK_LOG_MAGIC            0x4b52534fUL
+#define RK_LOG_PAGES            (RK_NUM_PAGES + RK_SPARE_PAGES)
+#define RK_RECORD_SIZE          (sizeof(RK_RECORD_HEADER) + sizeof(CTAP_residentKey))
+#define RK_RECORDS_PER_PAGE     ((PAGE_SIZE - sizeof(RK_PAGE_HEADER)) / RK_RECORD_SIZE)
+
+// Same number of slots as the fixed layout used before the log.  Together
+// with the format record this has to stay below the records that fit in
+// RK_LOG_PAGES - 1 pages, so that compaction always frees a record.
+#define RK_SLOTS                ((int)(RK_NUM_PAGES * RK_RECORDS_PER_PAGE))
+
+#define RK_RECORD_DATA          0x01
+#define RK_RECORD_DELETED       0x02
+#define RK_RECORD_FORMAT        0x03    // the pages hold a log, see rk_migrate
+
+#define RK_SLOT_FORMAT          0xffff
+
+// A record location is page * RK_RECORDS_PER_PAGE + record
+#define RK_LOC_NONE             0xff
+
+#define RK_PAGE_ERASED          0
+#define RK_PAGE_LOG             1
+#define RK_PAGE_OTHER           2       // legacy keys or an interrupted erase
+
+static uint8_t rk_loc[RK_SLOTS];
+static uint8_t rk_format_loc;
+static uint8_t rk_page_state[RK_LOG_PAGES];
+static uint8_t rk_live[RK_LOG_PAGES];
+static uint32_t rk_seq[RK_LOG_PAGES];
+static uint32_t rk_max_seq;
+static uint8_t rk_head;                 // page being appended to
+static uint8_t rk_head_next;            // next free record in the head page
+
+static uint8_t rk_page(uint8_t i)
+{
+    return (i < RK_NUM_PAGES) ? (RK_START_PAGE + i) : (RK_SPARE_START_PAGE + i - RK_NUM_PAGES);
+}
+
+static uint8_t * rk_page_ptr(uint8_t i)
+{
+    return (uint8_t *)(uintptr_t)flash_addr(rk_page(i));
+}
+
+static uint8_t * rk_record_ptr(uint8_t loc)
+{
+    return rk_page_ptr(loc / RK_RECORDS_PER_PAGE) + sizeof(RK_PAGE_HEADER) +
+           (loc % RK_RECORDS_PER_PAGE) * RK_RECORD_SIZE;
+}
+
+static int is_erased(uint8_t * p, uint32_t len)
+{
+    while (len--)
+    {
+        if (*p++ != 0xff)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static uint32_t rk_crc(uint32_t crc, const uint8_t * data, uint32_t len)
+{
+    int i;
+    crc = ~crc;
+    while (len--)
+    {
+        crc ^= *data++;
+        for (i = 0; i < 8; i++)
+        {
+            crc = (crc >> 1) ^ (0xedb88320UL & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+static uint32_t rk_record_crc(RK_RECORD_HEADER * h, const uint8_t * data)
+{
+    uint32_t crc = rk_crc(0, (uint8_t *)h, 3);
+    if (h->type == RK_RECORD_DATA)
+    {
+        crc = rk_crc(crc, data, sizeof(CTAP_residentKey));
+    }
+    return crc;
+}
+
+static uint8_t * rk_slot_loc(uint16_t slot)
+{
+    return (slot == RK_SLOT_FORMAT) ? &rk_format_loc : &rk_loc[slot];
+}
+
+// Point slot at the record at loc, releasing the record it replaces
+static void rk_index_set(uint16_t slot, uint8_t loc)
+{
+    uint8_t * l = rk_slot_loc(slot);
+    if (*l != RK_LOC_NONE)
+    {
+        rk_live[*l / RK_RECORDS_PER_PAGE]--;
+    }
+    *l = loc;
+    rk_live[loc / RK_RECORDS_PER_PAGE]++;
+}
+
+static void rk_erase(uint8_t i)
+{
+    flash_erase_page(rk_page(i));
+    rk_page_state[i] = RK_PAGE_ERASED;
+    rk_seq[i] = 0;
+    rk_live[i] = 0;
+}
+
+static int rk_erased_pages()
+{
+    int i, n = 0;
+    for (i = 0; i < RK_LOG_PAGES; i++)
+    {
+        n += (rk_page_state[i] == RK_PAGE_ERASED);
+    }
+    return n;
+}
+
+// Start appending to a fresh page
+static int8_t rk_open_page()
+{
+    RK_PAGE_HEADER h;
+    uint8_t i;
+    for (i = 0; i < RK_LOG_PAGES; i++)
+    {
+        if (rk_page_state[i] == RK_PAGE_ERASED)
+        {
+            h.magic = RK_LOG_MAGIC;
+            h.seq = ++rk_max_seq;
+            flash_write(flash_addr(rk_page(i)), (uint8_t *)&h, sizeof(h));
+            rk_page_state[i] = RK_PAGE_LOG;
+            rk_seq[i] = h.seq;
+            rk_head = i;
+            rk_head_next = 0;
+            return 0;
+        }
+    }
+    printf2(TAG_ERR, "No erased RK page\r\n");
+    return -1;
+}
+
+// Program a record at the head of the log and index it
+static void rk_append(RK_RECORD_HEADER * h, const uint8_t * data)
+{
+    uint8_t loc = rk_head * RK_RECORDS_PER_PAGE + rk_head_next;
+    uint32_t addr = flash_addr(rk_page(rk_head)) + sizeof(RK_PAGE_HEADER) + rk_head_next * RK_RECORD_SIZE;
+
+    flash_write(addr, (uint8_t *)h, sizeof(RK_RECORD_HEADER));
+    if (h->type == RK_RECORD_DATA)
+    {
+        flash_write(addr + sizeof(RK_RECORD_HEADER), (uint8_t *)data, sizeof(CTAP_residentKey));
+    }
+    rk_head_next++;
+    rk_index_set(h->slot, loc);
+}
+
+// LOG page other than the head with the fewest live records
+static uint8_t rk_emptiest_page()
+{
+    uint8_t i;
+    uint8_t victim = RK_LOC_NONE;
+    for (i = 0; i < RK_LOG_PAGES; i++)
+    {
+        if (rk_page_state[i] == RK_PAGE_LOG && i != rk_head &&
+            (victim == RK_LOC_NONE || rk_live[i] < rk_live[victim]))
+        {
+            victim = i;
+        }
+    }
+    return victim;
+}
+
+// Append the live records of page @victim to the head and erase it
+static void rk_move_page(uint8_t victim)
+{
+    uint8_t r, loc;
+    RK_RECORD_HEADER * h;
+
+    printf1(TAG_STOR, "compacting RK page %d (%d live)\r\n", victim, rk_live[victim]);
+
+    for (r = 0; r < RK_RECORDS_PER_PAGE; r++)
+    {
+        loc = victim * RK_RECORDS_PER_PAGE + r;
+        h = (RK_RECORD_HEADER *)rk_record_ptr(loc);
+        if (is_erased((uint8_t *)h, sizeof(RK_RECORD_HEADER)))
+        {
+            break;
+        }
+        if ((h->slot == RK_SLOT_FORMAT || h->slot < RK_SLOTS) && *rk_slot_loc(h->slot) == loc)
+        {
+            rk_append(h, (uint8_t *)(h + 1));
+        }
+    }
+    rk_erase(victim);
+}
+
+// Free a page by moving the emptiest one into the reserve page.  There are
+// more record spaces outside the full head than live records, so the page
+// picked always has one to spare.
+static int8_t rk_compact()
+{
+    uint8_t victim = rk_emptiest_page();
+    if (victim == RK_LOC_NONE || rk_live[victim] >= RK_RECORDS_PER_PAGE || rk_open_page() != 0)
+    {
+        return -1;
+    }
+    rk_move_page(victim);
+    return 0;
+}
+
+// Make sure the head page has room for one more record.  Outside of
+// migration one erased page is always kept in reserve for rk_compact.
+static int8_t rk_make_room(int use_reserve)
+{
+    if (rk_head != RK_LOC_NONE && rk_head_next < RK_RECORDS_PER_PAGE)
+    {
+        return 0;
+    }
+    if (rk_erased_pages() > 1 || (use_reserve && rk_erased_pages() > 0))
+    {
+        return rk_open_page();
+    }
+    return rk_compact();
+}
+
+static int8_t rk_write_record(uint16_t slot, uint8_t type, const uint8_t * data, int use_reserve)
+{
+    RK_RECORD_HEADER h;
+    if (rk_make_room(use_reserve) != 0)
+    {
+        return -1;
+    }
+    h.slot = slot;
+    h.type = type;
+    h.reserved = 0xff;
+    h.crc = rk_record_crc(&h, data);
+    rk_append(&h, data);
+    return 0;
+}
+
+// Read key @index of the fixed layout used before the log, where key i was
+// stored at byte i * sizeof(CTAP_residentKey) of the RK pages.
+// @return 0 if the key is there, -1 if the slot is empty or already moved.
+static int8_t rk_legacy_read(int index, CTAP_residentKey * rk)
+{
+    uint32_t start = index * sizeof(CTAP_residentKey);
+    uint32_t end = start + sizeof(CTAP_residentKey) - 1;
+    uint32_t p;
+    for (p = start / PAGE_SIZE; p <= end / PAGE_SIZE; p++)
+    {
+        if (rk_page_state[p] != RK_PAGE_OTHER)
+        {
+            return -1;
+        }
+    }
+    memmove(rk, (uint8_t *)(uintptr_t)flash_addr(RK_START_PAGE) + start, sizeof(CTAP_residentKey));
+    return is_erased((uint8_t *)rk, sizeof(CTAP_residentKey)) ? -1 : 0;
+}
+
+// @return 1 if page @p holds no legacy key from @n on.  Those pages are
+// either copied already or were reused by the log.
+static int rk_legacy_done(uint8_t p, int n)
+{
+    return p >= RK_NUM_PAGES || n >= RK_SLOTS ||
+           (uint32_t)(p + 1) * PAGE_SIZE <= n * sizeof(CTAP_residentKey) ||
+           (uint32_t)p * PAGE_SIZE >= RK_SLOTS * sizeof(CTAP_residentKey);
+}
+
+// Move keys from the fixed layout into the log, erasing each legacy page
+// once every key on it has been copied.  Safe to resume after power loss:
+// keys are copied in slot order and the log is only marked formatted at the
+// end.  On a blank device this just writes the format record.
+static void rk_migrate()
+{
+    CTAP_residentKey rk;
+    int next = 0;
+    int i;
+    uint8_t p;
+
+    for (i = 0; i < RK_SLOTS; i++)
+    {
+        if (rk_loc[i] != RK_LOC_NONE)
+        {
+            next = i + 1;
+        }
+    }
+
+    for (i = next; i <= RK_SLOTS; i++)
+    {
+        for (p = 0; p < RK_LOG_PAGES; p++)
+        {
+            if (rk_page_state[p] == RK_PAGE_OTHER && rk_legacy_done(p, i))
+            {
+                rk_erase(p);
+            }
+        }
+        if (i == RK_SLOTS)
+        {
+            break;
+        }
+        if (rk_legacy_read(i, &rk) == 0)
+        {
+            printf1(TAG_STOR, "migrating RK %d\r\n", i);
+            if (rk_write_record(i, RK_RECORD_DATA, (uint8_t *)&rk, 1) != 0)
+            {
+                printf2(TAG_ERR, "Out of space migrating RK %d\r\n", i);
+                return;
+            }
+        }
+    }
+
+    rk_write_record(RK_SLOT_FORMAT, RK_RECORD_FORMAT, NULL, 1);
+}
+
+static void rk_clear_index()
+{
+    memset(rk_loc, RK_LOC_NONE, sizeof(rk_loc));
+    memset(rk_live, 0, sizeof(rk_live));
+    rk_format_loc = RK_LOC_NONE;
+    rk_head = RK_LOC_NONE;
+    rk_head_next = 0;
+}
+
+void rk_store_init()
+{
+    RK_PAGE_HEADER * ph;
+    RK_RECORD_HEADER * h;
+    uint32_t last_seq = 0;
+    uint8_t i, p, r, loc;
+
+    rk_clear_index();
+    rk_max_seq = 0;
+
+    for (i = 0; i < RK_LOG_PAGES; i++)
+    {
+        ph = (RK_PAGE_HEADER *)rk_page_ptr(i);
+        rk_seq[i] = 0;
+        if (ph->magic == RK_LOG_MAGIC && ph->seq != 0xffffffff)
+        {
+            rk_page_state[i] = RK_PAGE_LOG;
+            rk_seq[i] = ph->seq;
+            if (ph->seq > rk_max_seq)
+            {
+                rk_max_seq = ph->seq;
+            }
+        }
+        else if (is_erased(rk_page_ptr(i), PAGE_SIZE))
+        {
+            rk_page_state[i] = RK_PAGE_ERASED;
+        }
+        else
+        {
+            rk_page_state[i] = RK_PAGE_OTHER;
+        }
+    }
+
+    // Replay the pages oldest first
+    while (1)
+    {
+        p = RK_LOC_NONE;
+        for (i = 0; i < RK_LOG_PAGES; i++)
+        {
+            if (rk_page_state[i] == RK_PAGE_LOG && rk_seq[i] > last_seq &&
+                (p == RK_LOC_NONE || rk_seq[i] < rk_seq[p]))
+            {
+                p = i;
+            }
+        }
+        if (p == RK_LOC_NONE)
+        {
+            break;
+        }
+        last_seq = rk_seq[p];
+
+        for (r = 0; r < RK_RECORDS_PER_PAGE; r++)
+        {
+            loc = p * RK_RECORDS_PER_PAGE + r;
+            h = (RK_RECORD_HEADER *)rk_record_ptr(loc);
+            if (is_erased((uint8_t *)h, sizeof(RK_RECORD_HEADER)))
+            {
+                break;
+            }
+            if (h->crc != rk_record_crc(h, (uint8_t *)(h + 1)))
+            {
+                printf2(TAG_ERR, "Skipping corrupt RK record %d\r\n", loc);
+                continue;
+            }
+            if (h->slot == RK_SLOT_FORMAT || h->slot < RK_SLOTS)
+            {
+                rk_index_set(h->slot, loc);
+            }
+        }
+        rk_head = p;
+        rk_head_next = r;
+    }
+
+    if (rk_format_loc == RK_LOC_NONE)
+    {
+        rk_migrate();
+    }
+    else
+    {
+        // Pages whose erase was interrupted
+        for (i = 0; i < RK_LOG_PAGES; i++)
+        {
+            if (rk_page_state[i] == RK_PAGE_OTHER)
+            {
+                rk_erase(i);
+            }
+        }
+
+        // Only an interrupted rk_compact leaves no erased page.  Its victim
+        // is still intact, so drop the partial copy and go back to it.
+        if (rk_erased_pages() == 0)
+        {
+            printf2(TAG_ERR, "warning, power interrupted during RK compaction\r\n");
+            rk_erase(rk_head);
+            rk_store_init();
+        }
+    }
+}
+
+void rk_store_reset()
+{
+    uint8_t i;
+    printf1(TAG_GREEN, "resetting RK \r\n");
+    for (i = 0; i < RK_LOG_PAGES; i++)
+    {
+        if (rk_page_state[i] != RK_PAGE_ERASED)
+        {
+            rk_erase(i);
+        }
+    }
+    rk_clear_index();
+    rk_write_record(RK_SLOT_FORMAT, RK_RECORD_FORMAT, NULL, 1);
+}
+
+uint32_t rk_store_size()
+{
+    return RK_SLOTS;
+}
+
+void rk_store_read(int index, CTAP_residentKey * rk)
+{
+    RK_RECORD_HEADER * h;
+    if (index < 0 || index >= RK_SLOTS)
+    {
+        printf2(TAG_ERR,"Out of bounds reading index %d for rk\n", index);
+        return;
+    }
+    if (rk_loc[index] == RK_LOC_NONE)
+    {
+        memset(rk, 0xff, sizeof(CTAP_residentKey));
+        return;
+    }
+    h = (RK_RECORD_HEADER *)rk_record_ptr(rk_loc[index]);
+    if (h->type != RK_RECORD_DATA)
+    {
+        memset(rk, 0xff, sizeof(CTAP_residentKey));
+        return;
+    }
+    memmove(rk, h + 1, sizeof(CTAP_residentKey));
+}
+
+int8_t rk_store_write(int index, CTAP_residentKey * rk)
+{
+    if (index < 0 || index >= RK_SLOTS)
+    {
+        printf2(TAG_ERR,"Out of bounds writing index %d for rk\n", index);
+        return -1;
+    }
+    return rk_write_record(index, RK_RECORD_DATA, (uint8_t *)rk, 0);
+}
+
+int8_t rk_store_delete(int index)
+{
+    if (index < 0 || index >= RK_SLOTS)
+    {
+        return -1;
+    }
+    if (rk_loc[index] == RK_LOC_NONE)
+    {
+        return 0;
+    }
+    return rk_write_record(index, RK_RECORD_DELETED, NULL, 0);
+}
@@ -0,0 +1,30 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+#ifndef _RK_STORE_H_
+#define _RK_STORE_H_
+
+#include <stdint.h>
+#include "ctap.h"
+
+// Scan the RK pages and rebuild the index.  Must be called once at boot
+// before any other rk_store function.
+void rk_store_init();
+
+// Erase every resident key.
+void rk_store_reset();
+
+// Number of resident key slots.
+uint32_t rk_store_size();
+
+// Read slot @index into @rk.  Empty slots read as erased flash (0xff).
+void rk_store_read(int index, CTAP_residentKey * rk);
+
+// @return 0 on success, -1 if index is out of bounds or flash is full.
+int8_t rk_store_write(int index, CTAP_residentKey * rk);
+int8_t rk_store_delete(int index);
+
+#endif
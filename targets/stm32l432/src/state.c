@@ -0,0 +1,53 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+
+// Authenticator state in STATE1_PAGE with a backup copy in STATE2_PAGE
+#include <stdint.h>
+#include <string.h>
+
+#include APP_CONFIG
+#include "device.h"
+#include "flash.h"
+#include "memory_layout.h"
+
+void authenticator_read_state(AuthenticatorState * a)
+{
+    uint32_t * ptr = (uint32_t *)flash_addr(STATE1_PAGE);
+    memmove(a,ptr,sizeof(AuthenticatorState));
+}
+
+void authenticator_read_backup_state(AuthenticatorState * a)
+{
+    uint32_t * ptr = (uint32_t *)flash_addr(STATE2_PAGE);
+    memmove(a,ptr,sizeof(AuthenticatorState));
+}
+
+// Return 1 yes backup is init'd, else 0
+int authenticator_is_backup_initialized()
+{
+    uint8_t header[16];
+    uint32_t * ptr = (uint32_t *)flash_addr(STATE2_PAGE);
+    memmove(header,ptr,16);
+    AuthenticatorState * state = (AuthenticatorState*)header;
+    return state->is_initialized == INITIALIZED_MARKER;
+}
+
+void authenticator_write_state(AuthenticatorState * a, int backup)
+{
+    if (! backup)
+    {
+        flash_erase_page(STATE1_PAGE);
+
+        flash_write(flash_addr(STATE1_PAGE), (uint8_t*)a, sizeof(AuthenticatorState));
+    }
+    else
+    {
+        flash_erase_page(STATE2_PAGE);
+
+        flash_write(flash_addr(STATE2_PAGE), (uint8_t*)a, sizeof(AuthenticatorState));
+    }
+}
@@ -0,0 +1,169 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+
+// Runs the flash traffic of common authenticator operations through the
+// storage code and the flash emulator.  For each workload it reports host
+// speed, speed on the device going by datasheet flash timings, erases per
+// page and how many operations it takes to wear out the busiest page.
+//
+//  usage: bench_storage [assertions] [rk registrations] [pin verifications]
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "flash.h"
+#include "flash_emu.h"
+#include "counter.h"
+#include "rk_store.h"
+#include "device.h"
+
+static AuthenticatorState state;
+
+// getAssertion and U2F authenticate
+static void op_assertion(uint32_t i)
+{
+    counter_increment();
+}
+
+// makeCredential with a resident key.  Once every slot is used, the same
+// accounts register again and overwrite their keys.
+static void op_rk_registration(uint32_t i)
+{
+    CTAP_residentKey rk;
+    uint32_t index = i % rk_store_size();
+
+    memset(&rk, 0, sizeof(rk));
+    rk.id.count = counter_increment();
+    memset(rk.id.rpIdHash, index, sizeof(rk.id.rpIdHash));
+
+    if (i < rk_store_size())
+    {
+        state.rk_stored++;
+        authenticator_write_state(&state, 0);
+        authenticator_write_state(&state, 1);
+    }
+    rk_store_write(index, &rk);
+}
+
+// Correct PIN: attempts are decremented first and reset on success
+static void op_pin_verification(uint32_t i)
+{
+    state.remaining_tries--;
+    authenticator_write_state(&state, 0);
+    state.remaining_tries = PIN_LOCKOUT_ATTEMPTS;
+    authenticator_write_state(&state, 0);
+}
+
+static const char * page_name(int page)
+{
+    static char name[16];
+    if (page == COUNTER1_PAGE) return "counter1";
+    if (page == COUNTER2_PAGE) return "counter2";
+    if (page == STATE1_PAGE) return "state1";
+    if (page == STATE2_PAGE) return "state2";
+    if (page >= RK_START_PAGE && page < RK_END_PAGE)
+    {
+        snprintf(name, sizeof(name), "rk%d", page - RK_START_PAGE);
+        return name;
+    }
+    if (page >= RK_SPARE_START_PAGE && page < RK_SPARE_START_PAGE + RK_SPARE_PAGES)
+    {
+        snprintf(name, sizeof(name), "rk spare%d", page - RK_SPARE_START_PAGE);
+        return name;
+    }
+    snprintf(name, sizeof(name), "page %d", page);
+    return name;
+}
+
+static void run(const char * name, void (*op)(uint32_t), uint32_t ops)
+{
+    struct timespec t1, t2;
+    double host_secs, device_secs;
+    uint32_t erases = 0, max_erases = 0;
+    int page, busiest = 0;
+    uint32_t i;
+
+    if (ops == 0)
+    {
+        return;
+    }
+
+    // Boot a blank device
+    flash_emu_init();
+    memset(&state, 0xff, sizeof(state));
+    state.is_initialized = INITIALIZED_MARKER;
+    state.remaining_tries = PIN_LOCKOUT_ATTEMPTS;
+    state.rk_stored = 0;
+    authenticator_write_state(&state, 0);
+    authenticator_write_state(&state, 1);
+    counter_init();
+    rk_store_init();
+    flash_emu_init_counters();
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    for (i = 0; i < ops; i++)
+    {
+        op(i);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+    host_secs = (t2.tv_sec - t1.tv_sec) + (t2.tv_nsec - t1.tv_nsec) / 1e9;
+    device_secs = flash_emu_time_us() / 1e6;
+
+    for (page = 0; page < PAGES; page++)
+    {
+        erases += flash_emu_erase_count(page);
+        if (flash_emu_erase_count(page) > max_erases)
+        {
+            max_erases = flash_emu_erase_count(page);
+            busiest = page;
+        }
+    }
+
+    printf("%u %s\n", ops, name);
+    printf("  host:      %.0f ops/s\n", ops / host_secs);
+    printf("  device:    %.0f ops/s, %.3f ms of flash time per op\n",
+            device_secs > 0 ? ops / device_secs : 0, device_secs * 1e3 / ops);
+    printf("  writes:    %u dwords, %u erases\n", flash_emu_write_count(), erases);
+    if (max_erases)
+    {
+        printf("  lifetime:  %.0f ops until %s reaches %d erases\n",
+                (double)FLASH_EMU_ENDURANCE * ops / max_erases, page_name(busiest), FLASH_EMU_ENDURANCE);
+    }
+    else
+    {
+        printf("  lifetime:  no erases\n");
+    }
+    printf("  erases:   ");
+    for (page = 0; page < PAGES; page++)
+    {
+        if (flash_emu_erase_count(page))
+        {
+            printf(" %s=%u", page_name(page), flash_emu_erase_count(page));
+        }
+    }
+    printf("\n\n");
+
+    if (flash_emu_errors())
+    {
+        printf("%u flash programming errors\n", flash_emu_errors());
+        exit(1);
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    uint32_t assertions = argc > 1 ? strtoul(argv[1], NULL, 0) : 1000000;
+    uint32_t registrations = argc > 2 ? strtoul(argv[2], NULL, 0) : 10000;
+    uint32_t pins = argc > 3 ? strtoul(argv[3], NULL, 0) : 10000;
+
+    run("assertions", op_assertion, assertions);
+    run("rk registrations", op_rk_registration, registrations);
+    run("pin verifications", op_pin_verification, pins);
+    return 0;
+}
@@ -0,0 +1,155 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "flash.h"
+#include "flash_emu.h"
+
+#define FLASH_BASE_ADDR     flash_addr(0)
+#define FLASH_SIZE          (PAGES * PAGE_SIZE)
+
+static uint8_t * flash_mem = NULL;
+static uint32_t erase_count[PAGES];
+static uint32_t write_count;
+static uint64_t time_us;
+static uint32_t errors;
+static int cut_ops = -1;
+static jmp_buf * cut_env;
+
+void flash_emu_init()
+{
+    if (flash_mem == NULL)
+    {
+        flash_mem = mmap((void *)(uintptr_t)FLASH_BASE_ADDR, FLASH_SIZE, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+        if (flash_mem != (void *)(uintptr_t)FLASH_BASE_ADDR)
+        {
+            perror("mmap flash");
+            exit(1);
+        }
+    }
+    memset(flash_mem, 0xff, FLASH_SIZE);
+    flash_emu_init_counters();
+    errors = 0;
+    cut_ops = -1;
+}
+
+void flash_emu_init_counters()
+{
+    memset(erase_count, 0, sizeof(erase_count));
+    write_count = 0;
+    time_us = 0;
+}
+
+uint32_t flash_emu_erase_count(uint8_t page)
+{
+    return erase_count[page];
+}
+
+uint32_t flash_emu_write_count()
+{
+    return write_count;
+}
+
+uint64_t flash_emu_time_us()
+{
+    return time_us;
+}
+
+uint32_t flash_emu_errors()
+{
+    return errors;
+}
+
+void flash_emu_power_cut(int ops, jmp_buf * env)
+{
+    cut_ops = ops;
+    cut_env = env;
+}
+
+// @return 1 if power is lost during this operation
+static int power_cut()
+{
+    if (cut_ops < 0)
+    {
+        return 0;
+    }
+    return cut_ops-- == 0;
+}
+
+void flash_erase_page(uint8_t page)
+{
+    if (page >= PAGES)
+    {
+        fprintf(stderr, "erase of page %d out of range\n", page);
+        errors++;
+        return;
+    }
+    if (power_cut())
+    {
+        memset(flash_mem + page * PAGE_SIZE, 0xff, PAGE_SIZE / 2);
+        longjmp(*cut_env, 1);
+    }
+    memset(flash_mem + page * PAGE_SIZE, 0xff, PAGE_SIZE);
+    erase_count[page]++;
+    time_us += FLASH_EMU_ERASE_US;
+}
+
+// Like the STM32L4, a dword can only be programmed once after an erase,
+// except that writing all zeros is always allowed.
+void flash_write_dword(uint32_t addr, uint64_t data)
+{
+    uint64_t old;
+    uint32_t off = addr - FLASH_BASE_ADDR;
+
+    if (addr < FLASH_BASE_ADDR || off >= FLASH_SIZE || (addr & 7))
+    {
+        fprintf(stderr, "write to bad address %08x\n", addr);
+        errors++;
+        return;
+    }
+    memmove(&old, flash_mem + off, 8);
+    if (old != 0xffffffffffffffffULL && data != 0)
+    {
+        fprintf(stderr, "write to programmed dword %08x\n", addr);
+        errors++;
+        return;
+    }
+    if (power_cut())
+    {
+        memmove(flash_mem + off, &data, 4);
+        longjmp(*cut_env, 1);
+    }
+    memmove(flash_mem + off, &data, 8);
+    write_count++;
+    time_us += FLASH_EMU_PROGRAM_US;
+}
+
+void flash_write(uint32_t addr, uint8_t * data, size_t sz)
+{
+    unsigned int i;
+    uint8_t buf[8];
+
+    // dword align
+    addr &= ~(0x07);
+
+    for(i = 0; i < sz; i+=8)
+    {
+        memmove(buf, data + i, (sz - i) > 8 ? 8 : sz - i);
+        if (sz - i < 8)
+        {
+            memset(buf + sz - i, 0xff, 8 - (sz - i));
+        }
+        flash_write_dword(addr, *(uint64_t*)buf);
+        addr += 8;
+    }
+}
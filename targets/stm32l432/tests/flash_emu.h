@@ -0,0 +1,47 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+#ifndef _FLASH_EMU_H_
+#define _FLASH_EMU_H_
+
+#include <stdint.h>
+#include <setjmp.h>
+#include "memory_layout.h"
+
+// Host replacement for flash.c.  The flash array is mapped at the real
+// flash address so storage code can keep reading it through flash_addr().
+
+// STM32L432 datasheet, typical page erase and 64 bit program times and
+// the guaranteed erase cycles per page.
+#define FLASH_EMU_ERASE_US      22020
+#define FLASH_EMU_PROGRAM_US    82
+#define FLASH_EMU_ENDURANCE     10000
+
+// Map the array and fill it with 0xff.  Safe to call again to start over.
+void flash_emu_init();
+
+// Zero the wear, write and time counters, keeping the flash contents.
+void flash_emu_init_counters();
+
+// Number of times @page has been erased since the counters were zeroed.
+uint32_t flash_emu_erase_count(uint8_t page);
+
+// Total dwords programmed since the counters were zeroed.
+uint32_t flash_emu_write_count();
+
+// Time the erases and writes since the counters were zeroed would take on
+// the device.
+uint64_t flash_emu_time_us();
+
+// Number of programming errors: a dword written twice without an erase.
+uint32_t flash_emu_errors();
+
+// Simulate power loss.  After @ops more page erases or dword writes, the
+// next one is left half done and execution longjmps to @env.  The cut
+// disarms itself; pass ops < 0 to disarm it early.
+void flash_emu_power_cut(int ops, jmp_buf * env);
+
+#endif
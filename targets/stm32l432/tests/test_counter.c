@@ -0,0 +1,128 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+
+#include "flash.h"
+#include "flash_emu.h"
+#include "counter.h"
+
+#define check(x) do { if (!(x)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #x); exit(1); } } while (0)
+
+// Enough counts to start a new counter page a few times
+#define WORKLOAD    1600
+
+static void test_counts()
+{
+    uint32_t last, c;
+    int i;
+
+    flash_emu_init();
+    counter_init();
+    last = counter_increment();
+    check(last != 0);
+    for (i = 0; i < WORKLOAD; i++)
+    {
+        c = counter_increment();
+        check(c > last);
+        check(c - last <= 3);       // skips a couple of counts on a new page
+        last = c;
+
+        // Rebooting continues from the same count
+        if (i % 97 == 0)
+        {
+            counter_init();
+            c = counter_increment();
+            check(c == last + 1);
+            last = c;
+        }
+    }
+    check(flash_emu_errors() == 0);
+    check(flash_emu_erase_count(COUNTER1_PAGE) <= WORKLOAD / 250 + 2);
+}
+
+// Counter written by firmware from before the tally
+static void test_upgrade()
+{
+    uint32_t erases = 7;
+    uint32_t c = erases * 256 + 1;
+    int offset;
+
+    flash_emu_init();
+    flash_write(flash_addr(COUNTER2_PAGE), (uint8_t*)&erases, 4);
+    for (offset = 0; offset < 100 * 2; offset += 2)
+    {
+        flash_write(flash_addr(COUNTER1_PAGE) + offset * 4, (uint8_t*)&c, 4);
+        c++;
+    }
+    counter_init();
+    check(counter_increment() > c);
+    check(flash_emu_errors() == 0);
+}
+
+// Cut power at every flash operation of the workload, and again at a
+// varying point while recovering.  No count may ever be returned twice.
+static void test_power_cut()
+{
+    static jmp_buf env;
+    volatile uint32_t last;
+    volatile int cut;
+    uint32_t c;
+    int i;
+
+    for (cut = 0; ; cut++)
+    {
+        flash_emu_init();
+        counter_init();
+        last = 0;
+
+        if (setjmp(env) == 0)
+        {
+            flash_emu_power_cut(cut, &env);
+            for (i = 0; i < WORKLOAD; i++)
+            {
+                last = counter_increment();
+            }
+            flash_emu_power_cut(-1, NULL);
+            // The workload finished before the cut, all points are covered
+            break;
+        }
+
+        if (setjmp(env) == 0)
+        {
+            flash_emu_power_cut(cut % 5, &env);
+        }
+        counter_init();
+        flash_emu_power_cut(-1, NULL);
+
+        c = counter_increment();
+        check(c > last);
+        last = c;
+        for (i = 0; i < 600; i++)
+        {
+            c = counter_increment();
+            check(c > last);
+            last = c;
+        }
+        counter_init();
+        check(counter_increment() > last);
+        check(flash_emu_errors() == 0);
+    }
+    printf("counter: survived power cuts at %d points\n", cut);
+}
+
+int main(int argc, char * argv[])
+{
+    test_counts();
+    test_upgrade();
+    test_power_cut();
+    printf("counter: all tests passed\n");
+    return 0;
+}
@@ -0,0 +1,320 @@
+// Copyright 2019 SoloKeys Developers
+//
+// Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+// http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+// http://opensource.org/licenses/MIT>, at your option. This file may not be
+// copied, modified, or distributed except according to those terms.
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <setjmp.h>
+
+#include "flash.h"
+#include "flash_emu.h"
+#include "rk_store.h"
+
+#define check(x) do { if (!(x)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #x); exit(1); } } while (0)
+
+static void make_rk(CTAP_residentKey * rk, int index, uint32_t version)
+{
+    memset(rk, 0, sizeof(CTAP_residentKey));
+    memset(rk->id.rpIdHash, index, sizeof(rk->id.rpIdHash));
+    rk->id.count = version;
+    rk->user.id_size = 8;
+    memmove(rk->user.id, &index, sizeof(index));
+    memmove(rk->user.id + 4, &version, sizeof(version));
+}
+
+static int is_empty(CTAP_residentKey * rk)
+{
+    uint8_t * p = (uint8_t *)rk;
+    unsigned int i;
+    for (i = 0; i < sizeof(CTAP_residentKey); i++)
+    {
+        if (p[i] != 0xff)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void check_rk(int index, uint32_t version)
+{
+    CTAP_residentKey want, got;
+    make_rk(&want, index, version);
+    rk_store_read(index, &got);
+    check(memcmp(&want, &got, sizeof(got)) == 0);
+}
+
+static void check_empty(int index)
+{
+    CTAP_residentKey rk;
+    rk_store_read(index, &rk);
+    check(is_empty(&rk));
+}
+
+static uint32_t rk_erases()
+{
+    uint32_t n = 0;
+    int i;
+    for (i = 0; i < RK_NUM_PAGES; i++)
+    {
+        n += flash_emu_erase_count(RK_START_PAGE + i);
+    }
+    for (i = 0; i < RK_SPARE_PAGES; i++)
+    {
+        n += flash_emu_erase_count(RK_SPARE_START_PAGE + i);
+    }
+    return n;
+}
+
+static void test_fresh()
+{
+    int i;
+    flash_emu_init();
+    rk_store_init();
+    check(rk_store_size() == 50);
+    for (i = 0; i < (int)rk_store_size(); i++)
+    {
+        check_empty(i);
+    }
+}
+
+static void test_store_overwrite()
+{
+    CTAP_residentKey rk;
+    uint32_t versions[50];
+    int i, n = rk_store_size();
+
+    flash_emu_init();
+    rk_store_init();
+
+    for (i = 0; i < n; i++)
+    {
+        make_rk(&rk, i, 0);
+        check(rk_store_write(i, &rk) == 0);
+        versions[i] = 0;
+    }
+    // Overwrite keys with a skewed pattern so compaction has to move data
+    for (i = 0; i < 5000; i++)
+    {
+        int index = (i % 3) ? (i % 4) : (i * 7) % n;
+        versions[index]++;
+        make_rk(&rk, index, versions[index]);
+        check(rk_store_write(index, &rk) == 0);
+    }
+    for (i = 0; i < n; i++)
+    {
+        check_rk(i, versions[i]);
+    }
+
+    // Survives a reboot
+    rk_store_init();
+    for (i = 0; i < n; i++)
+    {
+        check_rk(i, versions[i]);
+    }
+
+    check(rk_store_delete(7) == 0);
+    check_empty(7);
+    rk_store_init();
+    check_empty(7);
+    check_rk(8, versions[8]);
+
+    check(rk_store_write(n, &rk) != 0);
+    check(rk_store_write(-1, &rk) != 0);
+    check(flash_emu_errors() == 0);
+}
+
+static void test_reset()
+{
+    CTAP_residentKey rk;
+    int i;
+
+    flash_emu_init();
+    rk_store_init();
+    for (i = 0; i < 20; i++)
+    {
+        make_rk(&rk, i, 1);
+        rk_store_write(i, &rk);
+    }
+    rk_store_reset();
+    for (i = 0; i < 20; i++)
+    {
+        check_empty(i);
+    }
+    rk_store_init();
+    for (i = 0; i < 20; i++)
+    {
+        check_empty(i);
+    }
+    check(flash_emu_errors() == 0);
+}
+
+// Keys written by firmware before the log existed are moved into it
+static void test_migrate(int count)
+{
+    CTAP_residentKey rk;
+    int i;
+
+    flash_emu_init();
+    for (i = 0; i < count; i++)
+    {
+        make_rk(&rk, i, 3);
+        flash_write(flash_addr(RK_START_PAGE) + i * sizeof(CTAP_residentKey), (uint8_t *)&rk, sizeof(rk));
+    }
+    rk_store_init();
+    for (i = 0; i < (int)rk_store_size(); i++)
+    {
+        if (i < count)
+        {
+            check_rk(i, 3);
+        }
+        else
+        {
+            check_empty(i);
+        }
+    }
+
+    // Nothing left to migrate on the next boot
+    rk_store_init();
+    for (i = 0; i < count; i++)
+    {
+        check_rk(i, 3);
+    }
+    make_rk(&rk, 0, 4);
+    check(rk_store_write(0, &rk) == 0);
+    check_rk(0, 4);
+    check(flash_emu_errors() == 0);
+}
+
+// Cut power during the workload at every few flash operations, and again
+// while recovering.  Afterwards every key must hold the last version written
+// or, for the key being written, the one before it.
+static void test_power_cut(int migrate)
+{
+    static jmp_buf env;
+    static uint32_t versions[50];
+    CTAP_residentKey rk;
+    volatile int cut;
+    volatile int writing;
+    int i, index, n = rk_store_size();
+
+    for (cut = 0; ; cut += 9)
+    {
+        flash_emu_init();
+        if (!migrate)
+        {
+            rk_store_init();
+        }
+        for (i = 0; i < n; i++)
+        {
+            make_rk(&rk, i, 1);
+            if (migrate)
+            {
+                flash_write(flash_addr(RK_START_PAGE) + i * sizeof(CTAP_residentKey), (uint8_t *)&rk, sizeof(rk));
+            }
+            else
+            {
+                rk_store_write(i, &rk);
+            }
+            versions[i] = 1;
+        }
+        writing = -1;
+
+        if (setjmp(env) == 0)
+        {
+            flash_emu_power_cut(cut, &env);
+            if (migrate)
+            {
+                rk_store_init();
+            }
+            for (i = 0; i < 60; i++)
+            {
+                index = (i % 3) ? (i % 4) : (i * 7) % n;
+                writing = index;
+                make_rk(&rk, index, versions[index] + 1);
+                check(rk_store_write(index, &rk) == 0);
+                versions[index]++;
+                writing = -1;
+            }
+            flash_emu_power_cut(-1, NULL);
+            break;
+        }
+
+        if (setjmp(env) == 0)
+        {
+            flash_emu_power_cut(cut % 7, &env);
+        }
+        rk_store_init();
+        flash_emu_power_cut(-1, NULL);
+
+        for (i = 0; i < n; i++)
+        {
+            rk_store_read(i, &rk);
+            if (i == writing && rk.id.count == versions[i] + 1)
+            {
+                versions[i]++;
+            }
+            check_rk(i, versions[i]);
+        }
+        for (i = 0; i < 100; i++)
+        {
+            index = (i * 13) % n;
+            make_rk(&rk, index, ++versions[index]);
+            check(rk_store_write(index, &rk) == 0);
+        }
+        rk_store_init();
+        for (i = 0; i < n; i++)
+        {
+            check_rk(i, versions[i]);
+        }
+        check(flash_emu_errors() == 0);
+    }
+}
+
+static void bench_overwrite()
+{
+    CTAP_residentKey rk;
+    struct timespec t1, t2;
+    int i, n = 100000;
+    double secs;
+
+    flash_emu_init();
+    rk_store_init();
+    for (i = 0; i < (int)rk_store_size(); i++)
+    {
+        make_rk(&rk, i, 0);
+        rk_store_write(i, &rk);
+    }
+
+    uint32_t erases = rk_erases();
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    for (i = 0; i < n; i++)
+    {
+        make_rk(&rk, i % rk_store_size(), i);
+        rk_store_write(i % rk_store_size(), &rk);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+    secs = (t2.tv_sec - t1.tv_sec) + (t2.tv_nsec - t1.tv_nsec) / 1e9;
+
+    printf("rk overwrite: %.0f ops/s on host, %.3f page erases per overwrite (was 1.0)\n",
+            n / secs, (rk_erases() - erases) / (double)n);
+}
+
+int main(int argc, char * argv[])
+{
+    test_fresh();
+    test_store_overwrite();
+    test_reset();
+    test_migrate(50);
+    test_migrate(13);
+    test_power_cut(0);
+    test_power_cut(1);
+    bench_overwrite();
+    printf("rk_store: all tests passed\n");
+    return 0;
+}
@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+#
+# Copyright 2019 SoloKeys Developers
+#
+# Licensed under the Apache License, Version 2.0, <LICENSE-APACHE or
+# http://apache.org/licenses/LICENSE-2.0> or the MIT license <LICENSE-MIT or
+# http://opensource.org/licenses/MIT>, at your option. This file may not be
+# copied, modified, or distributed except according to those terms.
+#
+# Writes the fixed-base comb tables of crypto/p256/p256_table.h
+#
+#   usage: gen_p256_table.py [teeth ...] > crypto/p256/p256_table.h
+#
+import sys
+
+p = 0xFFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF
+n = 0xFFFFFFFF00000000FFFFFFFFFFFFFFFFBCE6FAADA7179E84F3B9CAC2FC632551
+b = 0x5AC635D8AA3A93E7B3EBBD55769886BC651D06B0CC53B0F63BCE3C3E27D2604B
+G = (
+    0x6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296,
+    0x4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5,
+)
+R = 1 << 256
+
+
+def add(P, Q):
+    if P is None:
+        return Q
+    if Q is None:
+        return P
+    if P[0] == Q[0]:
+        if (P[1] + Q[1]) % p == 0:
+            return None
+        l = (3 * P[0] * P[0] - 3) * pow(2 * P[1], p - 2, p) % p
+    else:
+        l = (Q[1] - P[1]) * pow(Q[0] - P[0], p - 2, p) % p
+    x = (l * l - P[0] - Q[0]) % p
+    return (x, (l * (P[0] - x) - P[1]) % p)
+
+
+def mul(k, P):
+    Q = None
+    while k:
+        if k & 1:
+            Q = add(Q, P)
+        P = add(P, P)
+        k >>= 1
+    return Q
+
+
+def words(x):
+    x = x * R % p
+    return ", ".join("0x%08x" % ((x >> (32 * i)) & 0xFFFFFFFF) for i in range(8))
+
+
+def table(teeth):
+    spacing = (256 + teeth - 1) // teeth
+    out = []
+    for idx in range(1, 1 << teeth):
+        k = sum(1 << (t * spacing) for t in range(teeth) if idx >> t & 1)
+        x, y = mul(k, G)
+        out.append("    {\n        P256_INT(%s),\n        P256_INT(%s),\n    }," % (words(x), words(y)))
+    return "\n".join(out)
+
+
+def main():
+    assert (G[1] ** 2 - G[0] ** 3 + 3 * G[0] - b) % p == 0
+    assert mul(n, G) is None
+    teeth = [int(t) for t in sys.argv[1:]] or [5, 8]
+
+    print("// Generated by tools/gen_p256_table.py, do not edit.")
+    print("//")
+    print("// Comb table for P256_COMB_TEETH teeth spaced d = ceil(256 / teeth) bits")
+    print("// apart.  Entry i - 1 is the sum of 2^(t*d) G over the set bits t of i,")
+    print("// as affine x, y in the Montgomery domain.")
+    for i, t in enumerate(teeth):
+        print("%s P256_COMB_TEETH == %d" % ("#if" if i == 0 else "#elif", t))
+        print("static const p256_int p256_comb_table[%d][2] = {" % ((1 << t) - 1))
+        print(table(t))
+        print("};")
+    print("#else")
+    print('#error "No comb table for P256_COMB_TEETH, generate one with tools/gen_p256_table.py"')
+    print("#endif")
+
+
+if __name__ == "__main__":
+    main()
@@ -964,6 +964,21 @@ class FIDO2Tests(Tester):
             except CtapError as e:
                 print(e)
 
+        if pin_code:
+            auth1 = self.testGA(
+                "Send GA request with no allow_list and no pin_auth, expect SUCCESS",
+                rp2["id"],
+                cdh,
+                expectedError=CtapError.ERR.SUCCESS,
+            )
+
+            with Test("Check no user names are returned without UV"):
+                assert auth1.number_of_credentials == 3
+                auth2 = self.ctap.get_next_assertion()
+                auth3 = self.ctap.get_next_assertion()
+                for x in (auth1, auth2, auth3):
+                    assert "id" in x.user.keys() and len(x.user.keys()) == 1
+
     def test_client_pin(self,):
         pin1 = "1234567890"
         self.test_rk(pin1)
@@ -73,6 +73,15 @@ class HIDTests(Tester):
             except CtapError as e:
                 assert e.code == CtapError.ERR.INVALID_LENGTH
 
+        with Test("Ping after CBOR msg with no data"):
+            self.send_raw("\x90\x00\x00")
+            cmd, r = self.recv_raw()
+            Tester.check_error(r, CtapError.ERR.INVALID_LENGTH)
+            pingdata = os.urandom(100)
+            r = self.send_data(CTAPHID.PING, pingdata)
+            if r != pingdata:
+                raise ValueError("Ping data not echo'd")
+
         with Test("No data in U2F msg"):
             try:
                 r = self.send_data(CTAPHID.MSG, "")